@@ -155,6 +155,154 @@ public:
     {
         return GetHash(ScaleToIntPoint(Point));
     }
+
+    // Integer Grid Utility
+
+    // Floor division, rounds towards negative infinity. Divisor must be positive.
+    FORCEINLINE static int32 FloorDiv(int32 A, int32 B)
+    {
+        check(B > 0);
+        const int32 Q = A / B;
+        return (A % B < 0) ? Q-1 : Q;
+    }
+
+    FORCEINLINE static FIntPoint FloorDiv(const FIntPoint& Point, int32 DivX, int32 DivY)
+    {
+        return FIntPoint(FloorDiv(Point.X, DivX), FloorDiv(Point.Y, DivY));
+    }
+
+    // Pack grid point into a collision free 64-bit key. Coordinates are
+    // sign-biased so that unsigned key order equals row-major (Y, X) order.
+    FORCEINLINE static uint64 PackGridKey(int32 X, int32 Y)
+    {
+        return
+            (static_cast<uint64>(static_cast<uint32>(Y) ^ 0x80000000u) << 32) |
+             static_cast<uint64>(static_cast<uint32>(X) ^ 0x80000000u);
+    }
+
+    FORCEINLINE static uint64 PackGridKey(const FIntPoint& Point)
+    {
+        return PackGridKey(Point.X, Point.Y);
+    }
+
+    FORCEINLINE static FIntPoint UnpackGridKey(uint64 Key)
+    {
+        return FIntPoint(
+            static_cast<int32>(static_cast<uint32>(Key) ^ 0x80000000u),
+            static_cast<int32>(static_cast<uint32>(Key >> 32) ^ 0x80000000u)
+            );
+    }
+
+    // Spread the bits of a 32-bit value into the even bits of a 64-bit value
+    FORCEINLINE static uint64 MortonSpreadBits(uint32 v)
+    {
+        uint64 x = v;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x <<  8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x <<  4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x <<  2)) & 0x3333333333333333ull;
+        x = (x | (x <<  1)) & 0x5555555555555555ull;
+        return x;
+    }
+
+    FORCEINLINE static uint32 MortonCompactBits(uint64 x)
+    {
+        x &= 0x5555555555555555ull;
+        x = (x | (x >>  1)) & 0x3333333333333333ull;
+        x = (x | (x >>  2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >>  4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >>  8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+        return static_cast<uint32>(x);
+    }
+
+    // Collision free 64-bit Morton (Z-order) key of sign-biased grid point
+    FORCEINLINE static uint64 GetMortonKey(int32 X, int32 Y)
+    {
+        return
+            MortonSpreadBits(static_cast<uint32>(X) ^ 0x80000000u) |
+           (MortonSpreadBits(static_cast<uint32>(Y) ^ 0x80000000u) << 1);
+    }
+
+    FORCEINLINE static uint64 GetMortonKey(const FIntPoint& Point)
+    {
+        return GetMortonKey(Point.X, Point.Y);
+    }
+
+    FORCEINLINE static FIntPoint GetMortonPoint(uint64 Key)
+    {
+        return FIntPoint(
+            static_cast<int32>(MortonCompactBits(Key) ^ 0x80000000u),
+            static_cast<int32>(MortonCompactBits(Key >> 1) ^ 0x80000000u)
+            );
+    }
+
+    // Collision free 64-bit Hilbert curve key of sign-biased grid point
+    FORCEINLINE static uint64 GetHilbertKey(int32 X, int32 Y)
+    {
+        uint32 x = static_cast<uint32>(X) ^ 0x80000000u;
+        uint32 y = static_cast<uint32>(Y) ^ 0x80000000u;
+        uint64 Key = 0;
+
+        for (int32 Level=31; Level>=0; --Level)
+        {
+            const uint32 rx = (x >> Level) & 1u;
+            const uint32 ry = (y >> Level) & 1u;
+
+            Key |= static_cast<uint64>((3u*rx) ^ ry) << (2*Level);
+
+            // Rotate quadrant
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = ~x;
+                    y = ~y;
+                }
+                Swap(x, y);
+            }
+        }
+
+        return Key;
+    }
+
+    FORCEINLINE static uint64 GetHilbertKey(const FIntPoint& Point)
+    {
+        return GetHilbertKey(Point.X, Point.Y);
+    }
+
+    FORCEINLINE static FIntPoint GetHilbertPoint(uint64 Key)
+    {
+        uint32 x = 0;
+        uint32 y = 0;
+
+        for (int32 Level=0; Level<32; ++Level)
+        {
+            const uint32 Quadrant = static_cast<uint32>(Key >> (2*Level)) & 3u;
+            const uint32 rx = (Quadrant >> 1) & 1u;
+            const uint32 ry = (Quadrant ^ rx) & 1u;
+            const uint32 LevelMask = (1u << Level) - 1u;
+
+            // Rotate quadrant
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = LevelMask - x;
+                    y = LevelMask - y;
+                }
+                Swap(x, y);
+            }
+
+            x |= rx << Level;
+            y |= ry << Level;
+        }
+
+        return FIntPoint(
+            static_cast<int32>(x ^ 0x80000000u),
+            static_cast<int32>(y ^ 0x80000000u)
+            );
+    }
 };
 
 FORCEINLINE FIntPoint operator+(const FIntPoint& LHS, int32 RHS)
@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+// Integer key sorting utility
+class FGULSortUtility
+{
+    template<typename FKeyType>
+    FORCEINLINE static int32 GetDigit(FKeyType Key, int32 Pass)
+    {
+        return static_cast<int32>((Key >> (Pass*8)) & 0xFF);
+    }
+
+    // Generate byte digit histograms of all radix passes
+    template<typename FKeyType>
+    static void GenerateDigitCounts(TArray<int32>& OutCounts, TArrayView<const FKeyType> Keys)
+    {
+        const int32 PassCount = sizeof(FKeyType);
+
+        OutCounts.Reset();
+        OutCounts.SetNumZeroed(PassCount*256);
+
+        for (const FKeyType Key : Keys)
+        {
+            for (int32 Pass=0; Pass<PassCount; ++Pass)
+            {
+                ++OutCounts[Pass*256 + GetDigit(Key, Pass)];
+            }
+        }
+    }
+
+    // Convert digit counts into exclusive write offsets, returns false
+    // if all keys share the same digit and the pass could be skipped
+    static bool GenerateDigitOffsets(int32* Counts, int32 Num)
+    {
+        int32 Offset = 0;
+
+        for (int32 d=0; d<256; ++d)
+        {
+            const int32 Count = Counts[d];
+
+            if (Count == Num)
+            {
+                return false;
+            }
+
+            Counts[d] = Offset;
+            Offset += Count;
+        }
+
+        return true;
+    }
+
+public:
+
+    // Stable LSD radix sort of element indices by unsigned integer keys.
+    //
+    // OutIndices receives key indices in ascending key order, elements with
+    // equal keys keep their input order. Byte passes where all keys share
+    // the same digit are skipped.
+    template<typename FKeyType>
+    static void RadixSortIndices(TArray<int32>& OutIndices, TArrayView<const FKeyType> Keys)
+    {
+        const int32 Num = Keys.Num();
+        const int32 PassCount = sizeof(FKeyType);
+
+        OutIndices.SetNumUninitialized(Num);
+
+        for (int32 i=0; i<Num; ++i)
+        {
+            OutIndices[i] = i;
+        }
+
+        if (Num < 2)
+        {
+            return;
+        }
+
+        TArray<int32> Counts;
+        GenerateDigitCounts(Counts, Keys);
+
+        TArray<int32> SortBuffer;
+        SortBuffer.SetNumUninitialized(Num);
+
+        for (int32 Pass=0; Pass<PassCount; ++Pass)
+        {
+            int32* PassOffsets = Counts.GetData() + Pass*256;
+
+            if (! GenerateDigitOffsets(PassOffsets, Num))
+            {
+                continue;
+            }
+
+            for (int32 i=0; i<Num; ++i)
+            {
+                const int32 KeyIndex = OutIndices[i];
+                SortBuffer[PassOffsets[GetDigit(Keys[KeyIndex], Pass)]++] = KeyIndex;
+            }
+
+            Swap(OutIndices, SortBuffer);
+        }
+    }
+
+    // Stable LSD radix sort of unsigned integer keys
+    template<typename FKeyType>
+    static void RadixSort(TArray<FKeyType>& Keys)
+    {
+        const int32 Num = Keys.Num();
+        const int32 PassCount = sizeof(FKeyType);
+
+        if (Num < 2)
+        {
+            return;
+        }
+
+        TArray<int32> Counts;
+        GenerateDigitCounts(Counts, TArrayView<const FKeyType>(Keys));
+
+        TArray<FKeyType> SortBuffer;
+        SortBuffer.SetNumUninitialized(Num);
+
+        for (int32 Pass=0; Pass<PassCount; ++Pass)
+        {
+            int32* PassOffsets = Counts.GetData() + Pass*256;
+
+            if (! GenerateDigitOffsets(PassOffsets, Num))
+            {
+                continue;
+            }
+
+            for (int32 i=0; i<Num; ++i)
+            {
+                const FKeyType Key = Keys[i];
+                SortBuffer[PassOffsets[GetDigit(Key, Pass)]++] = Key;
+            }
+
+            Swap(Keys, SortBuffer);
+        }
+    }
+
+    // Parallel stable LSD radix sort of unsigned integer keys.
+    //
+    // Keys are split into contiguous chunks. Each pass generates per chunk
+    // digit histograms and scatters chunks in parallel to digit-major,
+    // chunk-minor offsets. Falls back to serial sort for small inputs.
+    template<typename FKeyType>
+    static void ParallelRadixSort(TArray<FKeyType>& Keys, int32 MinChunkSize = 16384)
+    {
+        const int32 Num = Keys.Num();
+        const int32 PassCount = sizeof(FKeyType);
+        const int32 ChunkCount = FMath::Min(Num / FMath::Max(1, MinChunkSize), 64);
+
+        if (ChunkCount < 2)
+        {
+            RadixSort(Keys);
+            return;
+        }
+
+        const int32 ChunkSize = FMath::DivideAndRoundUp(Num, ChunkCount);
+
+        TArray<int32> Counts;
+        TArray<FKeyType> SortBuffer;
+        SortBuffer.SetNumUninitialized(Num);
+
+        for (int32 Pass=0; Pass<PassCount; ++Pass)
+        {
+            Counts.Reset();
+            Counts.SetNumZeroed(ChunkCount*256);
+
+            ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+            {
+                const int32 KeyStart = ChunkIndex*ChunkSize;
+                const int32 KeyEnd = FMath::Min(KeyStart+ChunkSize, Num);
+                int32* ChunkCounts = Counts.GetData() + ChunkIndex*256;
+
+                for (int32 i=KeyStart; i<KeyEnd; ++i)
+                {
+                    ++ChunkCounts[GetDigit(Keys[i], Pass)];
+                }
+            } );
+
+            // Convert counts into chunk write offsets, skip pass if all keys
+            // share the same digit
+
+            bool bSkipPass = false;
+            int32 Offset = 0;
+
+            for (int32 d=0; d<256 && ! bSkipPass; ++d)
+            {
+                const int32 DigitOffset = Offset;
+
+                for (int32 c=0; c<ChunkCount; ++c)
+                {
+                    int32& Count(Counts[c*256 + d]);
+                    const int32 ChunkOffset = Offset;
+                    Offset += Count;
+                    Count = ChunkOffset;
+                }
+
+                bSkipPass = (Offset-DigitOffset) == Num;
+            }
+
+            if (bSkipPass)
+            {
+                continue;
+            }
+
+            ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+            {
+                const int32 KeyStart = ChunkIndex*ChunkSize;
+                const int32 KeyEnd = FMath::Min(KeyStart+ChunkSize, Num);
+                int32* ChunkOffsets = Counts.GetData() + ChunkIndex*256;
+
+                for (int32 i=KeyStart; i<KeyEnd; ++i)
+                {
+                    const FKeyType Key = Keys[i];
+                    SortBuffer[ChunkOffsets[GetDigit(Key, Pass)]++] = Key;
+                }
+            } );
+
+            Swap(Keys, SortBuffer);
+        }
+    }
+};
@@ -142,6 +142,26 @@ public:
         EGULBox2DClip ClipCode
         );
 
+    FORCEINLINE static int32 GetBoundsOutcode(
+        const FVector2D& Point,
+        const FBox2D& Bounds
+        );
+
+    FORCEINLINE_DEBUGGABLE static bool SegmentIntersectsBounds(
+        const FVector2D& Point0,
+        const FVector2D& Point1,
+        const FBox2D& Bounds
+        );
+
+    // Batched SegmentIntersectsBounds() over segments (InPoints0[i], InPoints1[i]),
+    // segments are tested four at a time using vector registers
+    static void SegmentsIntersectBounds(
+        TArray<bool>& OutResults,
+        TArrayView<const FVector2D> InPoints0,
+        TArrayView<const FVector2D> InPoints1,
+        const FBox2D& Bounds
+        );
+
     FORCEINLINE static float PointDistToSegment2D(const FVector2D& Point, const FVector2D& StartPoint, const FVector2D& EndPoint);
 
     FORCEINLINE_DEBUGGABLE static bool IsPointOnBounds(const FVector2D& BoundsMin, const FVector2D& BoundsMax, const FVector2D& Point);
@@ -302,6 +322,55 @@ FORCEINLINE_DEBUGGABLE FVector2D UGULGeometryUtility::IntersectBounds(
     return FVector2D();
 }
 
+FORCEINLINE int32 UGULGeometryUtility::GetBoundsOutcode(
+    const FVector2D& Point,
+    const FBox2D& Bounds
+    )
+{
+    return
+        ((Point.Y < Bounds.Min.Y) ? EGULBox2DClip::B2DCLIP_B : 0) |
+        ((Point.Y > Bounds.Max.Y) ? EGULBox2DClip::B2DCLIP_T : 0) |
+        ((Point.X < Bounds.Min.X) ? EGULBox2DClip::B2DCLIP_L : 0) |
+        ((Point.X > Bounds.Max.X) ? EGULBox2DClip::B2DCLIP_R : 0);
+}
+
+FORCEINLINE_DEBUGGABLE bool UGULGeometryUtility::SegmentIntersectsBounds(
+    const FVector2D& Point0,
+    const FVector2D& Point1,
+    const FBox2D& Bounds
+    )
+{
+    const int32 Code0 = GetBoundsOutcode(Point0, Bounds);
+    const int32 Code1 = GetBoundsOutcode(Point1, Bounds);
+
+    // Trivial accept, either end point is within bounds
+    if (Code0 == 0 || Code1 == 0)
+    {
+        return true;
+    }
+
+    // Trivial reject, both end points are outside the same bounds side
+    if ((Code0 & Code1) != 0)
+    {
+        return false;
+    }
+
+    // Segment spans the bounds on both axes, intersects if bounds
+    // corners are not all on the same side of the segment line
+
+    const FVector2D D(Point1-Point0);
+
+    const float C00 = D ^ (FVector2D(Bounds.Min.X, Bounds.Min.Y)-Point0);
+    const float C10 = D ^ (FVector2D(Bounds.Max.X, Bounds.Min.Y)-Point0);
+    const float C01 = D ^ (FVector2D(Bounds.Min.X, Bounds.Max.Y)-Point0);
+    const float C11 = D ^ (FVector2D(Bounds.Max.X, Bounds.Max.Y)-Point0);
+
+    const float CMin = FMath::Min(FMath::Min(C00, C10), FMath::Min(C01, C11));
+    const float CMax = FMath::Max(FMath::Max(C00, C10), FMath::Max(C01, C11));
+
+    return CMin <= 0.f && CMax >= 0.f;
+}
+
 FORCEINLINE float UGULGeometryUtility::PointDistToSegment2D(const FVector2D& Point, const FVector2D& StartPoint, const FVector2D& EndPoint)
 {
     const FVector2D ClosestPoint(FMath::ClosestPointOnSegment2D(Point, StartPoint, EndPoint));
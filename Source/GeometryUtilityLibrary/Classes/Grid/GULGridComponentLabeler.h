@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+#include "Grid/GULGridTypes.h"
+
+class FGULSparseGrid;
+
+// Parallel connected component grid labeler.
+//
+// Labels four-connected components of non-boundary cells within inclusive
+// grid bounds. Rows are split into row band tiles that are labeled in
+// parallel with a two-pass union-find labeling, band seams are then merged
+// and component labels are resolved in parallel.
+//
+// Union-find parents always point to a lower cell index, which keeps
+// component roots at their first cell in row-major order.
+class GEOMETRYUTILITYLIBRARY_API FGULGridComponentLabeler
+{
+    FIntPoint BoundsMin = FIntPoint::ZeroValue;
+    FIntPoint BoundsMax = FIntPoint(-1, -1);
+    int32 Stride = 0;
+    int32 RowCount = 0;
+    int32 RowBandSize = 64;
+
+    TBitArray<> BoundaryStates;
+
+    // Component index per cell, INDEX_NONE for boundary cells
+    TArray<int32> Labels;
+
+    TArray<FGULGridComponent> Components;
+
+    // Component areas per row band, used to generate component points
+    TArray<TMap<int32, int32>> BandComponentAreas;
+
+    FORCEINLINE int32 GetBandNum() const
+    {
+        return (RowCount+RowBandSize-1) / RowBandSize;
+    }
+
+    FORCEINLINE static int32 FindRoot(TArray<int32>& Parents, int32 Index);
+    FORCEINLINE static int32 FindRootConst(const TArray<int32>& Parents, int32 Index);
+    FORCEINLINE static void Union(TArray<int32>& Parents, int32 IndexA, int32 IndexB);
+
+    void LabelRowBand(TArray<int32>& Parents, int32 Row0, int32 Row1) const;
+
+public:
+
+    FGULGridComponentLabeler() = default;
+
+    FGULGridComponentLabeler(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+    {
+        Init(InBoundsMin, InBoundsMax);
+    }
+
+    void Init(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax);
+
+    // Mark on-bounds points as boundary cells
+    void SetBoundaryPoints(const TArray<FIntPoint>& Points);
+
+    // Mark on-bounds sparse grid cells as boundary cells
+    void SetBoundaryGrid(const FGULSparseGrid& Grid);
+
+    // Label connected components, boundary cells must be assigned beforehand
+    void Label(int32 InRowBandSize = 64);
+
+    FORCEINLINE bool IsOnBounds(const FIntPoint& Point) const
+    {
+        return
+            Point.X >= BoundsMin.X && Point.Y >= BoundsMin.Y &&
+            Point.X <= BoundsMax.X && Point.Y <= BoundsMax.Y;
+    }
+
+    FORCEINLINE int32 GetComponentNum() const
+    {
+        return Components.Num();
+    }
+
+    FORCEINLINE const TArray<FGULGridComponent>& GetComponents() const
+    {
+        return Components;
+    }
+
+    // Component index of the specified point,
+    // INDEX_NONE for boundary or out of bounds points
+    FORCEINLINE int32 GetLabel(const FIntPoint& Point) const
+    {
+        if (! IsOnBounds(Point) || Labels.Num() < 1)
+        {
+            return INDEX_NONE;
+        }
+
+        return Labels[(Point.X-BoundsMin.X) + (Point.Y-BoundsMin.Y)*Stride];
+    }
+
+    // Generate component points in row-major order.
+    //
+    // ComponentGroupIndices maps component index to output group index,
+    // components mapped to INDEX_NONE are skipped. Output groups must
+    // already exist, group points are overwritten.
+    void GenerateComponentPoints(
+        TArray<FGULIntPointGroup>& OutPointGroups,
+        const TArray<int32>& ComponentGroupIndices
+        ) const;
+};
+
+FORCEINLINE int32 FGULGridComponentLabeler::FindRoot(TArray<int32>& Parents, int32 Index)
+{
+    // Path halving
+    while (Parents[Index] != Index)
+    {
+        Parents[Index] = Parents[Parents[Index]];
+        Index = Parents[Index];
+    }
+    return Index;
+}
+
+FORCEINLINE int32 FGULGridComponentLabeler::FindRootConst(const TArray<int32>& Parents, int32 Index)
+{
+    while (Parents[Index] != Index)
+    {
+        Index = Parents[Index];
+    }
+    return Index;
+}
+
+FORCEINLINE void FGULGridComponentLabeler::Union(TArray<int32>& Parents, int32 IndexA, int32 IndexB)
+{
+    const int32 RootA = FindRoot(Parents, IndexA);
+    const int32 RootB = FindRoot(Parents, IndexB);
+
+    // Link to the lower root index
+    if (RootA < RootB)
+    {
+        Parents[RootB] = RootA;
+    }
+    else
+    if (RootB < RootA)
+    {
+        Parents[RootA] = RootB;
+    }
+}
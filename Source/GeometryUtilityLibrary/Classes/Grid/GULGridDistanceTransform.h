@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GULGridTypes.h"
+
+// Dense grid distance transform over inclusive grid bounds.
+//
+// Generates the distance of every cell within bounds to the nearest seed
+// cell. Euclidean and Manhattan distances are computed with separable
+// column then row passes, each pass runs in parallel across columns or rows.
+// Euclidean distance uses the lower envelope of parabolas (Felzenszwalb and
+// Huttenlocher). Chamfer distance uses a sequential two-pass raster scan.
+class GEOMETRYUTILITYLIBRARY_API FGULGridDistanceTransform
+{
+    FIntPoint BoundsMin = FIntPoint::ZeroValue;
+    FIntPoint BoundsMax = FIntPoint(-1, -1);
+    int32 Stride = 0;
+    int32 RowCount = 0;
+
+    // Cell distances, MAX_FLT for cells without any reachable seed
+    TArray<float> Distances;
+
+    // Per column step distance to nearest column seed
+    void GenerateColumnDistances(TArray<int32>& OutColumnDistances, const TBitArray<>& SeedStates) const;
+
+    void GenerateEuclidean(const TBitArray<>& SeedStates);
+    void GenerateManhattan(const TBitArray<>& SeedStates);
+    void GenerateChamfer(const TBitArray<>& SeedStates);
+
+public:
+
+    FGULGridDistanceTransform() = default;
+
+    FGULGridDistanceTransform(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+    {
+        Init(InBoundsMin, InBoundsMax);
+    }
+
+    void Init(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax);
+
+    // Generate distances to seed points, out-of-bounds seeds are ignored.
+    // Returns false if there is no valid seed point.
+    bool Generate(const TArray<FIntPoint>& SeedPoints, EGULGridDistanceMetric Metric);
+
+    FORCEINLINE int32 GetStride() const
+    {
+        return Stride;
+    }
+
+    FORCEINLINE int32 GetCellCount() const
+    {
+        return Stride*RowCount;
+    }
+
+    FORCEINLINE bool IsOnBounds(const FIntPoint& Point) const
+    {
+        return
+            Point.X >= BoundsMin.X && Point.Y >= BoundsMin.Y &&
+            Point.X <= BoundsMax.X && Point.Y <= BoundsMax.Y;
+    }
+
+    FORCEINLINE int32 GetIndex(const FIntPoint& Point) const
+    {
+        return (Point.X-BoundsMin.X) + (Point.Y-BoundsMin.Y)*Stride;
+    }
+
+    FORCEINLINE const TArray<float>& GetDistances() const
+    {
+        return Distances;
+    }
+
+    FORCEINLINE float GetDistance(const FIntPoint& Point) const
+    {
+        return Distances[GetIndex(Point)];
+    }
+
+    FORCEINLINE void MoveDistances(TArray<float>& OutDistances)
+    {
+        OutDistances = MoveTemp(Distances);
+    }
+
+    // Quantize distances to 16-bit, values are scaled, rounded and clamped
+    void GetDistancesUInt16(TArray<uint16>& OutDistances, float DistanceScale = 1.f) const;
+};
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULMathLibrary.h"
+#include "GULTypes.h"
+#include "Grid/GULGridTypes.h"
+
+// Persistent incremental grid rasterization cache of poly groups.
+//
+// Boundary cells of each poly ring are cached grouped by tiles of
+// (TileDimensionX, TileDimensionY) cells, the same tiling used by
+// UGULGridUtility::GroupGridsByDimensionAndBounds(). Each tile holds the
+// unique boundary cells of all rings touching it and the isolated point
+// groups filled within the tile fill bounds, the tile bounds clipped to the
+// bounds of all boundary cells.
+//
+// Tile point groups are fragments of isolated components spanning the whole
+// fill bounds. Fragments are merged across tile edges into labeled
+// components, tiles without boundary cells within the fill bounds are
+// interior tiles fully covered by a single component. Merged components
+// match the point groups of UGULGridUtility::GenerateIsolatedPointGroups()
+// over all ring boundary cells. Components touching the fill bounds edges
+// are outside of all closed rings.
+//
+// On update, rings are diffed against the cache by point hash and bounds.
+// Only changed rings are re-rasterized and only tiles touched by their old or
+// new bounds, or tiles with changed fill bounds, are recomputed. Components
+// are then resolved from tile edge labels, which scales with the tile count
+// of the fill bounds rather than its cell count.
+class GEOMETRYUTILITYLIBRARY_API FGULGridRasterCache
+{
+public:
+
+    struct FRingTile
+    {
+        int32 RingIndex;
+        int32 TileIndex;
+
+        FRingTile(int32 InRingIndex, int32 InTileIndex)
+            : RingIndex(InRingIndex)
+            , TileIndex(InTileIndex)
+        {
+        }
+    };
+
+    struct FTile
+    {
+        // Rings touching the tile and their tile range indices
+        TArray<FRingTile> RingTiles;
+        TArray<FIntPoint> BoundaryCells;
+
+        // Inclusive tile fill bounds
+        FIntPoint FillMin = FIntPoint::ZeroValue;
+        FIntPoint FillMax = FIntPoint(-1, -1);
+
+        // Isolated point groups within tile fill bounds, their summaries and
+        // the index of the merged component each group belongs to
+        TArray<FGULIntPointGroup> PointGroups;
+        TArray<FGULGridComponent> PointGroupComponents;
+        TArray<int32> ComponentIds;
+
+        // Point group index of fill bounds edge cells, INDEX_NONE for
+        // boundary cells. Bottom and top rows followed by left and right
+        // columns.
+        TArray<int32> EdgeLabels;
+    };
+
+private:
+
+    struct FRing
+    {
+        uint32 Hash = 0;
+        int32 PointCount = 0;
+        FBox2D Bounds = FBox2D(ForceInitToZero);
+
+        // Inclusive cell bounds, invalid for rings without cells
+        FIntPoint CellMin = FIntPoint::ZeroValue;
+        FIntPoint CellMax = FIntPoint(-1, -1);
+
+        // Unique cells ordered by tile, tile i cells are within
+        // [TileOffsets[i], TileOffsets[i+1])
+        TArray<FIntPoint> TileIds;
+        TArray<int32> TileOffsets;
+        TArray<FIntPoint> Cells;
+    };
+
+    int32 GridSizeX;
+    int32 GridSizeY;
+    int32 TileDimensionX;
+    int32 TileDimensionY;
+    EGULGridFillMode FillMode;
+    bool bClosedPolygons;
+    int32 GridSizePerSegment;
+
+    TArray<FRing> Rings;
+    TMap<FIntPoint, FTile> Tiles;
+    TArray<FIntPoint> DirtyTileIds;
+
+    // Inclusive bounds of all ring cells
+    FIntPoint FillBoundsMin = FIntPoint::ZeroValue;
+    FIntPoint FillBoundsMax = FIntPoint(-1, -1);
+
+    // Merged components and interior tile component indices over the fill
+    // bounds tile range, INDEX_NONE for tiles with boundary cells
+    TArray<FGULGridComponent> Components;
+    FIntPoint TileRangeMin = FIntPoint::ZeroValue;
+    FIntPoint TileRangeMax = FIntPoint(-1, -1);
+    TArray<int32> InteriorTileComponents;
+
+    static void GetRingKey(uint32& OutHash, FBox2D& OutBounds, const TArray<FVector2D>& Points);
+
+    FORCEINLINE static int32 FindRoot(TArray<int32>& Parents, int32 Index);
+    FORCEINLINE static void Union(TArray<int32>& Parents, int32 IndexA, int32 IndexB);
+
+    FORCEINLINE static bool HasValidBounds(const FIntPoint& BoundsMin, const FIntPoint& BoundsMax)
+    {
+        return BoundsMin.X <= BoundsMax.X && BoundsMin.Y <= BoundsMax.Y;
+    }
+
+    void AddDirtyTiles(TSet<FIntPoint>& DirtyTileSet, const FRing& Ring) const;
+    void GetTileFillBounds(const FIntPoint& TileId, FIntPoint& OutFillMin, FIntPoint& OutFillMax) const;
+
+    void BuildRing(FRing& Ring, const TArray<FVector2D>& Points) const;
+    void BuildTile(const FIntPoint& TileId, FTile& Tile) const;
+    void ResolveComponents();
+
+public:
+
+    FGULGridRasterCache(
+        int32 InGridSizeX = 1,
+        int32 InGridSizeY = 1,
+        int32 InTileDimensionX = 64,
+        int32 InTileDimensionY = 64,
+        EGULGridFillMode InFillMode = EGULGridFillMode::Queue,
+        bool bInClosedPolygons = true,
+        int32 InGridSizePerSegment = 10
+        );
+
+    void Reset();
+
+    // Update cache with poly groups, rings are matched to the cache by index.
+    // Returns the number of dirty tiles.
+    int32 Update(const TArray<FGULVector2DGroup>& InPolys);
+
+    // Tiles touched by the old or new bounds of rings changed by the last
+    // update and tiles with changed fill bounds. Dirty tiles without
+    // boundary cells are not part of the cached tiles.
+    FORCEINLINE const TArray<FIntPoint>& GetDirtyTileIds() const
+    {
+        return DirtyTileIds;
+    }
+
+    FORCEINLINE const TMap<FIntPoint, FTile>& GetTiles() const
+    {
+        return Tiles;
+    }
+
+    FORCEINLINE const FTile* FindTile(const FIntPoint& TileId) const
+    {
+        return Tiles.Find(TileId);
+    }
+
+    FORCEINLINE int32 GetRingCount() const
+    {
+        return Rings.Num();
+    }
+
+    FORCEINLINE FIntPoint GetTileId(const FIntPoint& GridId) const
+    {
+        return UGULMathLibrary::FloorDiv(GridId, TileDimensionX, TileDimensionY);
+    }
+
+    // Inclusive bounds of all boundary cells, returns false if empty
+    FORCEINLINE bool GetFillBounds(FIntPoint& OutBoundsMin, FIntPoint& OutBoundsMax) const
+    {
+        OutBoundsMin = FillBoundsMin;
+        OutBoundsMax = FillBoundsMax;
+        return HasValidBounds(FillBoundsMin, FillBoundsMax);
+    }
+
+    FORCEINLINE const TArray<FGULGridComponent>& GetComponents() const
+    {
+        return Components;
+    }
+
+    // Component index of an interior tile, INDEX_NONE for tiles with
+    // boundary cells or tiles outside the fill bounds
+    FORCEINLINE int32 GetInteriorTileComponent(const FIntPoint& TileId) const
+    {
+        if (TileId.X < TileRangeMin.X || TileId.Y < TileRangeMin.Y ||
+            TileId.X > TileRangeMax.X || TileId.Y > TileRangeMax.Y)
+        {
+            return INDEX_NONE;
+        }
+
+        const int32 Stride = TileRangeMax.X-TileRangeMin.X+1;
+        return InteriorTileComponents[(TileId.X-TileRangeMin.X) + (TileId.Y-TileRangeMin.Y)*Stride];
+    }
+
+    // Unique boundary cells of all cached tiles
+    void GetBoundaryCells(TArray<FIntPoint>& OutGridIds) const;
+
+    // Merged component points, one point group per component
+    void GetPointGroups(TArray<FGULIntPointGroup>& OutPointGroups) const;
+};
+
+FORCEINLINE int32 FGULGridRasterCache::FindRoot(TArray<int32>& Parents, int32 Index)
+{
+    // Path halving
+    while (Parents[Index] != Index)
+    {
+        Parents[Index] = Parents[Parents[Index]];
+        Index = Parents[Index];
+    }
+    return Index;
+}
+
+FORCEINLINE void FGULGridRasterCache::Union(TArray<int32>& Parents, int32 IndexA, int32 IndexB)
+{
+    const int32 RootA = FindRoot(Parents, IndexA);
+    const int32 RootB = FindRoot(Parents, IndexB);
+
+    // Link to the lower root index
+    if (RootA < RootB)
+    {
+        Parents[RootB] = RootA;
+    }
+    else
+    if (RootB < RootA)
+    {
+        Parents[RootA] = RootB;
+    }
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+#include "Grid/GULGridScanConverter.h"
+#include "Poly/GULPolyTypes.h"
+
+// Narrow band signed distance field rasterizer of poly shapes.
+//
+// Generates signed distances from grid cell centers to the nearest shape
+// edge, negative inside shapes. Distances are only evaluated within the band
+// width around edges, cells outside the band are clamped to +/- band width.
+//
+// Edges are binned into square cell tiles by their band expanded bounds and
+// tiles are rasterized in parallel. Inside states are resolved by the scan
+// converter center sample parity, even-odd per shape and union across shapes.
+class GEOMETRYUTILITYLIBRARY_API FGULGridSDFRasterizer
+{
+    struct FEdge
+    {
+        FVector2D P0;
+        FVector2D P01;
+        float InvLengthSq;
+        FBox2D Bounds;
+    };
+
+    FVector2D GridSize;
+
+    TArray<FEdge> Edges;
+    FGULGridScanConverter ScanConverter;
+
+    void AddRing(TArrayView<const FVector2D> Points);
+
+    FORCEINLINE static float GetDistanceSquared(const FEdge& Edge, const FVector2D& Point)
+    {
+        const FVector2D P0P(Point-Edge.P0);
+        const float t = FMath::Clamp((P0P | Edge.P01) * Edge.InvLengthSq, 0.f, 1.f);
+        return (P0P - Edge.P01*t).SizeSquared();
+    }
+
+public:
+
+    FGULGridSDFRasterizer(int32 InGridSizeX = 1, int32 InGridSizeY = 1);
+
+    void Reset();
+
+    FORCEINLINE bool HasEdges() const
+    {
+        return Edges.Num() > 0;
+    }
+
+    // Add each poly as a separate shape
+    void AddPolyGroups(const TArray<FGULVector2DGroup>& PolyGroups);
+
+    // Add each indexed poly group as a shape (outer poly with holes)
+    void AddIndexedPolyGroups(
+        const TArray<FGULIndexedPolyGroup>& IndexGroups,
+        const TArray<FGULVector2DGroup>& PolyGroups
+        );
+
+    // Generate signed distances over cell bounds covering the band expanded
+    // shape bounds. Distances are indexed by
+    // (X-OutBoundsMin.X) + (Y-OutBoundsMin.Y)*Stride.
+    bool Generate(
+        TArray<float>& OutDistances,
+        FIntPoint& OutBoundsMin,
+        FIntPoint& OutBoundsMax,
+        float BandWidth,
+        int32 TileSize = 64
+        ) const;
+};
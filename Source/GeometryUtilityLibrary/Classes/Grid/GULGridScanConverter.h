@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+#include "Grid/GULGridTypes.h"
+#include "Grid/GULGridSpanSet.h"
+#include "Poly/GULPolyTypes.h"
+#include "Poly/GULPolySoup.h"
+
+// Active edge table poly scan converter.
+//
+// Converts poly shapes into the grid cells they cover. A cell is covered if
+// its center lies inside a shape or if any shape edge touches the cell.
+// Each shape is filled with the even-odd rule over its own rings, covered
+// cells of separate shapes are merged as union.
+//
+// Rows are converted independently in parallel row bands, output spans are
+// sorted by row then by span start.
+class GEOMETRYUTILITYLIBRARY_API FGULGridScanConverter
+{
+public:
+
+    // Shape edge in grid space, P0.Y <= P1.Y
+    struct FEdge
+    {
+        FVector2D P0;
+        FVector2D P1;
+        int32 ShapeIndex;
+    };
+
+private:
+
+    FVector2D GridSize;
+
+    TArray<FEdge> Edges;
+    int32 ShapeCount = 0;
+
+    float MinY = BIG_NUMBER;
+    float MaxY = -BIG_NUMBER;
+
+    void ConvertRowBand(
+        TArray<FGULGridSpan>& OutSpans,
+        TArrayView<const int32> BandEdgeIndices,
+        int32 Row0,
+        int32 Row1,
+        bool bIncludeEdgeCells
+        ) const;
+
+public:
+
+    FGULGridScanConverter(int32 InGridSizeX = 1, int32 InGridSizeY = 1);
+
+    void Reset();
+
+    FORCEINLINE bool HasEdges() const
+    {
+        return Edges.Num() > 0;
+    }
+
+    FORCEINLINE int32 GetShapeNum() const
+    {
+        return ShapeCount;
+    }
+
+    // Begin a new even-odd shape, subsequent rings are added to this shape
+    int32 AddShape();
+
+    // Add closed ring to the last added shape
+    void AddRing(TArrayView<const FVector2D> Points);
+
+    // Add each poly as a separate shape
+    void AddPolyGroups(const TArray<FGULVector2DGroup>& PolyGroups);
+
+    // Add each indexed poly group as a shape (outer poly with holes)
+    void AddIndexedPolyGroups(
+        const TArray<FGULIndexedPolyGroup>& IndexGroups,
+        const TArray<FGULVector2DGroup>& PolyGroups
+        );
+
+    // Add each poly soup ring as a separate shape
+    void AddPolySoup(const FGULPolySoup& PolySoup);
+
+    // Generate covered cell spans. If edge cells are excluded, only cells
+    // with centers inside shapes are generated.
+    void GenerateSpans(
+        TArray<FGULGridSpan>& OutSpans,
+        int32 RowBandSize = 64,
+        bool bIncludeEdgeCells = true
+        ) const;
+
+    // Generate covered cell spans as run-length encoded cell set
+    void GenerateSpans(
+        FGULGridSpanSet& OutSpanSet,
+        int32 RowBandSize = 64,
+        bool bIncludeEdgeCells = true
+        ) const;
+
+    void GenerateGridIds(
+        TArray<FIntPoint>& OutGridIds,
+        int32 RowBandSize = 64,
+        bool bIncludeEdgeCells = true
+        ) const;
+};
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GULGridTypes.h"
+
+// Run-length encoded grid cell set.
+//
+// Cells are stored as inclusive row spans sorted by row then span start.
+// Spans on the same row never overlap or touch, so each cell set has exactly
+// one span representation. Set operations sweep span boundaries row by row
+// without expanding spans into cells.
+class GEOMETRYUTILITYLIBRARY_API FGULGridSpanSet
+{
+    enum class EOperation : uint8
+    {
+        Union,
+        Intersection,
+        Difference
+    };
+
+    TArray<FGULGridSpan> Spans;
+    int32 CellCount = 0;
+
+    static void Combine(
+        FGULGridSpanSet& OutSet,
+        const FGULGridSpanSet& A,
+        const FGULGridSpanSet& B,
+        EOperation Operation
+        );
+
+    // Sort and merge overlapping or touching spans, drops empty spans
+    void Normalize();
+
+    // Index of the first span after the span that could contain the point
+    int32 UpperBound(const FIntPoint& Point) const;
+
+public:
+
+    FGULGridSpanSet() = default;
+
+    explicit FGULGridSpanSet(const TArray<FGULGridSpan>& InSpans)
+    {
+        SetSpans(InSpans);
+    }
+
+    explicit FGULGridSpanSet(TArray<FGULGridSpan>&& InSpans)
+    {
+        SetSpans(MoveTemp(InSpans));
+    }
+
+    void Reset();
+
+    FORCEINLINE int32 Num() const
+    {
+        return CellCount;
+    }
+
+    FORCEINLINE bool IsEmpty() const
+    {
+        return CellCount < 1;
+    }
+
+    FORCEINLINE int32 GetSpanNum() const
+    {
+        return Spans.Num();
+    }
+
+    FORCEINLINE const TArray<FGULGridSpan>& GetSpans() const
+    {
+        return Spans;
+    }
+
+    // Span iteration, spans are visited in row-major order
+    FORCEINLINE const FGULGridSpan* begin() const
+    {
+        return Spans.GetData();
+    }
+
+    FORCEINLINE const FGULGridSpan* end() const
+    {
+        return Spans.GetData() + Spans.Num();
+    }
+
+    // Assign arbitrary spans, spans may be unsorted and overlapping
+    void SetSpans(const TArray<FGULGridSpan>& InSpans);
+    void SetSpans(TArray<FGULGridSpan>&& InSpans);
+
+    void AddSpan(const FGULGridSpan& Span);
+
+    bool Contains(const FIntPoint& Point) const;
+
+    // Inclusive cell bounds, returns false on empty set
+    bool GetBounds(FIntPoint& OutBoundsMin, FIntPoint& OutBoundsMax) const;
+
+    // Cell conversions
+
+    void SetPoints(TArrayView<const FIntPoint> Points);
+
+    FORCEINLINE void SetPoints(const TArray<FIntPoint>& Points)
+    {
+        SetPoints(TArrayView<const FIntPoint>(Points));
+    }
+
+    static FGULGridSpanSet FromPoints(TArrayView<const FIntPoint> Points)
+    {
+        FGULGridSpanSet SpanSet;
+        SpanSet.SetPoints(Points);
+        return SpanSet;
+    }
+
+    // Visit cells in row-major order
+    void ForEach(TFunctionRef<void(const FIntPoint&)> Callback) const;
+
+    void ToPoints(TArray<FIntPoint>& OutPoints) const;
+
+    FORCEINLINE TArray<FIntPoint> ToPoints() const
+    {
+        TArray<FIntPoint> Points;
+        ToPoints(Points);
+        return Points;
+    }
+
+    // Set operations, output set may alias either input set
+
+    FORCEINLINE static void Union(FGULGridSpanSet& OutSet, const FGULGridSpanSet& A, const FGULGridSpanSet& B)
+    {
+        Combine(OutSet, A, B, EOperation::Union);
+    }
+
+    FORCEINLINE static void Intersection(FGULGridSpanSet& OutSet, const FGULGridSpanSet& A, const FGULGridSpanSet& B)
+    {
+        Combine(OutSet, A, B, EOperation::Intersection);
+    }
+
+    FORCEINLINE static void Difference(FGULGridSpanSet& OutSet, const FGULGridSpanSet& A, const FGULGridSpanSet& B)
+    {
+        Combine(OutSet, A, B, EOperation::Difference);
+    }
+};
@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULGridTypes.generated.h"
+
+UENUM(BlueprintType)
+enum class EGULGridFillMode : uint8
+{
+    // Four-neighbour cell queue flood fill
+    Queue,
+
+    // Scanline flood fill, fills whole row spans per visit
+    Scanline,
+
+    // Parallel connected component labeling, labels all isolated groups
+    // in one pass. Single target fills fall back to scanline fill.
+    Labeling
+};
+
+UENUM(BlueprintType)
+enum class EGULGridDistanceMetric : uint8
+{
+    // Exact Euclidean distance
+    Euclidean,
+
+    // Two-pass chamfer distance with unit and diagonal steps
+    Chamfer,
+
+    // Four-neighbour step distance
+    Manhattan
+};
+
+UENUM(BlueprintType)
+enum class EGULGridOrder : uint8
+{
+    // Row-major (Y, X) order
+    RowMajor,
+
+    // Morton (Z-order) curve order
+    Morton,
+
+    // Hilbert curve order, consecutive curve cells are always adjacent
+    Hilbert
+};
+
+// Inclusive grid row span [X0, X1] on row Y
+USTRUCT(BlueprintType)
+struct GEOMETRYUTILITYLIBRARY_API FGULGridSpan
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Y = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 X0 = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 X1 = -1;
+
+    FGULGridSpan() = default;
+
+    FGULGridSpan(int32 InY, int32 InX0, int32 InX1)
+        : Y(InY)
+        , X0(InX0)
+        , X1(InX1)
+    {
+    }
+
+    FORCEINLINE int32 Num() const
+    {
+        return X1-X0+1;
+    }
+};
+
+USTRUCT(BlueprintType)
+struct GEOMETRYUTILITYLIBRARY_API FGULGridSpanGroup
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FGULGridSpan> Spans;
+};
+
+// Connected grid component summary
+USTRUCT(BlueprintType)
+struct GEOMETRYUTILITYLIBRARY_API FGULGridComponent
+{
+    GENERATED_BODY()
+
+    // Component cell count
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 Area = 0;
+
+    // Inclusive component cell bounds
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FIntPoint BoundsMin = FIntPoint(MAX_int32, MAX_int32);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FIntPoint BoundsMax = FIntPoint(MIN_int32, MIN_int32);
+
+    FORCEINLINE void Add(int32 X, int32 Y)
+    {
+        ++Area;
+        BoundsMin.X = FMath::Min(BoundsMin.X, X);
+        BoundsMin.Y = FMath::Min(BoundsMin.Y, Y);
+        BoundsMax.X = FMath::Max(BoundsMax.X, X);
+        BoundsMax.Y = FMath::Max(BoundsMax.Y, Y);
+    }
+
+    FORCEINLINE void Add(const FGULGridComponent& Component)
+    {
+        Area += Component.Area;
+        BoundsMin.X = FMath::Min(BoundsMin.X, Component.BoundsMin.X);
+        BoundsMin.Y = FMath::Min(BoundsMin.Y, Component.BoundsMin.Y);
+        BoundsMax.X = FMath::Max(BoundsMax.X, Component.BoundsMax.X);
+        BoundsMax.Y = FMath::Max(BoundsMax.Y, Component.BoundsMax.Y);
+    }
+};
+
+// Dense grid cell states over inclusive grid bounds [BoundsMin, BoundsMax].
+//
+// Each cell holds one bit each for boundary and visited states,
+// addressed by grid index (X-BoundsMin.X) + (Y-BoundsMin.Y)*Stride.
+class FGULGridCellStates
+{
+    FIntPoint BoundsMin = FIntPoint::ZeroValue;
+    FIntPoint BoundsMax = FIntPoint(-1, -1);
+    int32 Stride = 0;
+
+    TBitArray<> BoundaryStates;
+    TBitArray<> VisitedStates;
+
+public:
+
+    FGULGridCellStates() = default;
+
+    FGULGridCellStates(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+    {
+        Init(InBoundsMin, InBoundsMax);
+    }
+
+    FORCEINLINE void Init(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+    {
+        check(InBoundsMin.X <= InBoundsMax.X && InBoundsMin.Y <= InBoundsMax.Y);
+
+        BoundsMin = InBoundsMin;
+        BoundsMax = InBoundsMax;
+        Stride = (BoundsMax.X-BoundsMin.X)+1;
+
+        const int32 CellCount = Stride * ((BoundsMax.Y-BoundsMin.Y)+1);
+
+        // Clear states in place when reused with the same cell count
+
+        if (BoundaryStates.Num() == CellCount && VisitedStates.Num() == CellCount)
+        {
+            BoundaryStates.SetRange(0, CellCount, false);
+            VisitedStates.SetRange(0, CellCount, false);
+        }
+        else
+        {
+            BoundaryStates.Init(false, CellCount);
+            VisitedStates.Init(false, CellCount);
+        }
+    }
+
+    FORCEINLINE const FIntPoint& GetBoundsMin() const
+    {
+        return BoundsMin;
+    }
+
+    FORCEINLINE const FIntPoint& GetBoundsMax() const
+    {
+        return BoundsMax;
+    }
+
+    FORCEINLINE int32 GetStride() const
+    {
+        return Stride;
+    }
+
+    FORCEINLINE int32 GetCellCount() const
+    {
+        return BoundaryStates.Num();
+    }
+
+    FORCEINLINE bool IsOnBounds(const FIntPoint& Point) const
+    {
+        return
+            Point.X >= BoundsMin.X && Point.Y >= BoundsMin.Y &&
+            Point.X <= BoundsMax.X && Point.Y <= BoundsMax.Y;
+    }
+
+    FORCEINLINE int32 GetIndex(const FIntPoint& Point) const
+    {
+        return (Point.X-BoundsMin.X) + (Point.Y-BoundsMin.Y)*Stride;
+    }
+
+    FORCEINLINE FIntPoint GetPoint(int32 Index) const
+    {
+        return FIntPoint(BoundsMin.X + (Index%Stride), BoundsMin.Y + (Index/Stride));
+    }
+
+    // Cell state access by grid index
+
+    FORCEINLINE bool IsBoundary(int32 Index) const
+    {
+        return BoundaryStates[Index];
+    }
+
+    FORCEINLINE bool IsVisited(int32 Index) const
+    {
+        return VisitedStates[Index];
+    }
+
+    FORCEINLINE bool IsBoundaryOrVisited(int32 Index) const
+    {
+        return BoundaryStates[Index] || VisitedStates[Index];
+    }
+
+    FORCEINLINE void SetBoundary(int32 Index)
+    {
+        BoundaryStates[Index] = true;
+    }
+
+    FORCEINLINE void SetVisited(int32 Index)
+    {
+        VisitedStates[Index] = true;
+    }
+
+    // Mark consecutive cells as visited
+    FORCEINLINE void SetVisitedRange(int32 Index, int32 Count)
+    {
+        VisitedStates.SetRange(Index, Count, true);
+    }
+
+    // Mark on-bounds points as boundary cells
+    FORCEINLINE void SetBoundaryPoints(const TArray<FIntPoint>& Points)
+    {
+        for (const FIntPoint& Point : Points)
+        {
+            if (IsOnBounds(Point))
+            {
+                SetBoundary(GetIndex(Point));
+            }
+        }
+    }
+};
+
+// Thread-safe cell bit array for parallel grid visits.
+//
+// Bits are packed into 32-bit words updated with compare-exchange, so
+// concurrent set and clear on neighbouring cells never lose updates.
+class FGULGridAtomicBitArray
+{
+    TArray<int32> Words;
+
+    FORCEINLINE static int32 GetBitMask(int32 Index)
+    {
+        return static_cast<int32>(1u << (Index & 31));
+    }
+
+public:
+
+    FORCEINLINE void Init(int32 BitCount)
+    {
+        Words.Reset();
+        Words.SetNumZeroed((BitCount+31) / 32);
+    }
+
+    FORCEINLINE bool Get(int32 Index) const
+    {
+        return (FPlatformAtomics::AtomicRead(&Words[Index >> 5]) & GetBitMask(Index)) != 0;
+    }
+
+    // Set bit, returns true if this call changed the bit from unset to set
+    FORCEINLINE bool TrySet(int32 Index)
+    {
+        volatile int32* Word = &Words[Index >> 5];
+        const int32 Mask = GetBitMask(Index);
+
+        int32 OldWord = FPlatformAtomics::AtomicRead(Word);
+
+        while (! (OldWord & Mask))
+        {
+            const int32 PrevWord = FPlatformAtomics::InterlockedCompareExchange(Word, OldWord | Mask, OldWord);
+
+            if (PrevWord == OldWord)
+            {
+                return true;
+            }
+
+            OldWord = PrevWord;
+        }
+
+        return false;
+    }
+
+    FORCEINLINE void Clear(int32 Index)
+    {
+        volatile int32* Word = &Words[Index >> 5];
+        const int32 Mask = GetBitMask(Index);
+
+        int32 OldWord = FPlatformAtomics::AtomicRead(Word);
+
+        while (OldWord & Mask)
+        {
+            const int32 PrevWord = FPlatformAtomics::InterlockedCompareExchange(Word, OldWord & ~Mask, OldWord);
+
+            if (PrevWord == OldWord)
+            {
+                break;
+            }
+
+            OldWord = PrevWord;
+        }
+    }
+};
+
+// Growable ring buffer queue of grid points.
+//
+// Points are stored contiguously in a power-of-two capacity buffer,
+// enqueue does not allocate unless the queue is full. Reset() keeps
+// the allocated capacity for reuse.
+class FGULGridPointQueue
+{
+    TArray<FIntPoint> Points;
+    int32 Head = 0;
+    int32 Count = 0;
+
+    void Grow(int32 MinCapacity)
+    {
+        const int32 Capacity = Points.Num();
+        const int32 NewCapacity = FMath::RoundUpToPowerOfTwo(FMath::Max(64, MinCapacity));
+
+        TArray<FIntPoint> NewPoints;
+        NewPoints.SetNumUninitialized(NewCapacity);
+
+        for (int32 i=0; i<Count; ++i)
+        {
+            NewPoints[i] = Points[(Head+i) & (Capacity-1)];
+        }
+
+        Points = MoveTemp(NewPoints);
+        Head = 0;
+    }
+
+public:
+
+    FORCEINLINE void Reset()
+    {
+        Head = 0;
+        Count = 0;
+    }
+
+    FORCEINLINE void Reserve(int32 InCapacity)
+    {
+        if (InCapacity > Points.Num())
+        {
+            Grow(InCapacity);
+        }
+    }
+
+    FORCEINLINE bool IsEmpty() const
+    {
+        return Count == 0;
+    }
+
+    FORCEINLINE int32 Num() const
+    {
+        return Count;
+    }
+
+    FORCEINLINE void Enqueue(const FIntPoint& Point)
+    {
+        if (Count == Points.Num())
+        {
+            Grow(Count*2);
+        }
+
+        Points[(Head+Count) & (Points.Num()-1)] = Point;
+        ++Count;
+    }
+
+    FORCEINLINE bool Dequeue(FIntPoint& OutPoint)
+    {
+        if (Count == 0)
+        {
+            return false;
+        }
+
+        OutPoint = Points[Head];
+        Head = (Head+1) & (Points.Num()-1);
+        --Count;
+
+        return true;
+    }
+};
+
+// Reusable working memory for single-threaded grid fills.
+//
+// Passing the same scratch object to consecutive fills reuses cell state,
+// queue and stack allocations across calls.
+struct FGULGridScratch
+{
+    FGULGridCellStates CellStates;
+    FGULGridPointQueue VisitQueue;
+    FGULGridPointQueue NextVisitQueue;
+    TArray<FIntPoint> SeedStack;
+    TArray<FGULGridSpan> Spans;
+};
+
+// Inlined grid visitor callback constraint. Null pointers and TFunction
+// objects are excluded, they resolve to the TFunction overloads where an
+// empty callback accepts all cells.
+template<typename FCallback>
+struct TGULIsInlineGridCallback
+{
+    typedef typename TDecay<FCallback>::Type FDecayedCallback;
+
+    enum
+    {
+        Value = ! TIsTFunction<FDecayedCallback>::Value
+             && ! TIsSame<FDecayedCallback, TYPE_OF_NULLPTR>::Value
+    };
+};
@@ -29,9 +29,14 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "GULMathLibrary.h"
 #include "GULTypes.h"
 #include "Geom/GULGeometryUtilityLibrary.h"
 #include "Poly/GULPolyTypes.h"
+#include "Poly/GULPolySoup.h"
+#include "Grid/GULGridTypes.h"
+#include "Grid/GULSparseGrid.h"
+#include "Grid/GULGridSpanSet.h"
 #include "GULGridUtility.generated.h"
 
 UCLASS()
@@ -39,24 +44,92 @@ class GEOMETRYUTILITYLIBRARY_API UGULGridUtility : public UBlueprintFunctionLibr
 {
 	GENERATED_BODY()
 
+    // Fill functions accept FGULGridCellStates or FGULGridSparseCellStates
+
+    template<typename FCellStates>
     static void PointFill(
         TArray<FIntPoint>& OutPoints,
-        const TSet<int32>& BoundaryIndexSet,
-        const FIntPoint& BoundsMin,
-        const FIntPoint& BoundsMax,
+        FCellStates& CellStates,
+        FGULGridPointQueue& VisitQueue,
+        const FIntPoint& FillTargetPoint
+        );
+
+    template<typename FCellStates>
+    static void SpanFill(
+        TArray<FGULGridSpan>& OutSpans,
+        FCellStates& CellStates,
+        TArray<FIntPoint>& SeedStack,
+        const FIntPoint& FillTargetPoint
+        );
+
+    template<typename FCellStates>
+    static void PointFillByMode(
+        TArray<FIntPoint>& OutPoints,
+        FCellStates& CellStates,
+        FGULGridScratch& Scratch,
         const FIntPoint& FillTargetPoint,
-        TSet<int32>* VisitedSet = nullptr
+        EGULGridFillMode FillMode
+        );
+
+    // Visit unfilled non-boundary neighbours of boundary cells in boundary
+    // cell iteration order. Boundary cells are either a point array or a
+    // sparse grid.
+    template<typename FCellStates, typename FBoundaryCells>
+    static void VisitIsolatedFillTargets(
+        FCellStates& CellStates,
+        const FBoundaryCells& BoundaryCells,
+        TFunctionRef<void(const FIntPoint&)> FillCallback
         );
 
+    // Label isolated point groups with a parallel connected component
+    // labeling, output groups follow boundary neighbour visit order
+    template<typename FBoundaryCells>
+    static void GenerateLabeledPointGroups(
+        TArray<FGULIntPointGroup>& OutPointGroups,
+        TArray<FGULGridComponent>& OutComponents,
+        const FBoundaryCells& BoundaryCells,
+        const FIntPoint& BoundsMin,
+        const FIntPoint& BoundsMax
+        );
+
+    static void FilterBoundaryPointsWithinBounds(
+        TArray<FIntPoint>& OutBoundaryPoints,
+        FIntPoint& BoundsMin,
+        FIntPoint& BoundsMax,
+        const TArray<FIntPoint>& BoundaryPoints
+        );
+
+    // Fill from multiple target points. Target points are not part of the
+    // output, out-of-bounds target points are ignored.
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
     static void PointFillMulti(
         TArray<FIntPoint>& OutPoints,
+        FGULGridScratch& Scratch,
         const FIntPoint& BoundsMin,
         const FIntPoint& BoundsMax,
         const TArray<FIntPoint>& TargetPoints,
-        TFunction<bool(int32, FIntPoint)> VisitCallback = nullptr
+        FCallback&& VisitCallback
         );
 
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
     static void VisitPoints(
+        FGULGridScratch& Scratch,
+        const FIntPoint& BoundsMin,
+        const FIntPoint& BoundsMax,
+        const TArray<FIntPoint>& TargetPoints,
+        FCallback&& VisitCallback
+        );
+
+    static void AppendSegmentsOnBounds(
+        TArray<FVector2D>& OutSegmentPoints,
+        TArray<bool>& SegmentResults,
+        TArrayView<const FVector2D> InPoints0,
+        TArrayView<const FVector2D> InPoints1,
+        const FBox2D& Bounds,
+        float RadiusSq
+        );
+
+    static void VisitPointsParallel(
         const FIntPoint& BoundsMin,
         const FIntPoint& BoundsMax,
         const TArray<FIntPoint>& TargetPoints,
@@ -70,15 +143,14 @@ class GEOMETRYUTILITYLIBRARY_API UGULGridUtility : public UBlueprintFunctionLibr
         const TArray<FIntPoint>& BoundaryPoints
         );
 
-    inline static void GenerateIndexSet(
-        TSet<int32>& OutIndexSet,
-        const TArray<FIntPoint>& InPoints,
-        const FIntPoint& Origin,
-        int32 Stride
-        );
-
     FORCEINLINE static int32 GetBoundsStride(const FIntPoint& BoundsMin, const FIntPoint& BoundsMax);
 
+    static void GenerateIsolatedGroupReferencePoints(
+        TArray<FVector2D>& OutReferencePoints,
+        const TArray<FGULIntPointGroup>& InPointGroups,
+        int32 GridSize
+        );
+
 public:
 
     template<typename FGridContainer>
@@ -102,86 +174,56 @@ public:
 
         FIntPoint ID0(GetGridId(P0, DimensionX, DimensionY));
         FIntPoint ID1(GetGridId(P1, DimensionX, DimensionY));
-        FVector2D DimF(DimensionX, DimensionY);
 
-        while (ID0 != ID1)
-        {
-            FBox2D Bounds(ForceInitToZero);
-            Bounds += FVector2D(ID0.X, ID0.Y) * DimF;
-            Bounds += Bounds.Min + DimF;
+        // Remaining cell steps on each axis, the walk always ends on ID1
+        int32 StepCountX = FMath::Abs(ID1.X-ID0.X);
+        int32 StepCountY = FMath::Abs(ID1.Y-ID0.Y);
 
-            // Find X-Axis intersection
+        // Segment parameter of the next cell boundary crossing (TMax)
+        // and between consecutive cell boundary crossings (TDelta).
+        // Parameters are scaled by |DX*DY| and kept in double precision
+        // so that exact corner crossings compare as exact ties.
 
-            FVector2D SegX0;
-            FVector2D SegX1;
+        const double AbsDX = FMath::Abs(DX);
+        const double AbsDY = FMath::Abs(DY);
 
-            if (SgnX > 0)
-            {
-                SegX0 = FVector2D(Bounds.Max.X, Bounds.Min.Y);
-                SegX1 = FVector2D(Bounds.Max.X, Bounds.Max.Y);
-            }
-            else
-            {
-                SegX0 = FVector2D(Bounds.Min.X, Bounds.Min.Y);
-                SegX1 = FVector2D(Bounds.Min.X, Bounds.Max.Y);
-            }
+        double TMaxX = 0.0;
+        double TMaxY = 0.0;
+        double TDeltaX = 0.0;
+        double TDeltaY = 0.0;
 
-            bool bIntersectX = UGULGeometryUtility::SegmentIntersection2D(
-                P0,
-                P1,
-                SegX0,
-                SegX1
-                );
-
-            if (bIntersectX)
-            {
-                ID0.X += SgnX;
-                OutGridIds.Emplace(ID0);
-                continue;
-            }
-
-            // Find Y-Axis intersection
+        if (StepCountX > 0)
+        {
+            const double BoundaryX = static_cast<double>(ID0.X + ((SgnX > 0) ? 1 : 0)) * DimensionX;
+            TMaxX = FMath::Abs(BoundaryX-P0.X) * AbsDY;
+            TDeltaX = DimensionX * AbsDY;
+        }
 
-            FVector2D SegY0;
-            FVector2D SegY1;
+        if (StepCountY > 0)
+        {
+            const double BoundaryY = static_cast<double>(ID0.Y + ((SgnY > 0) ? 1 : 0)) * DimensionY;
+            TMaxY = FMath::Abs(BoundaryY-P0.Y) * AbsDX;
+            TDeltaY = DimensionY * AbsDX;
+        }
 
-            if (SgnY > 0)
+        while (StepCountX > 0 || StepCountY > 0)
+        {
+            // Step on X-Axis on ties, corner crossings
+            // pass through the X-Axis neighbour cell
+            if (StepCountY < 1 || (StepCountX > 0 && TMaxX <= TMaxY))
             {
-                SegY0 = FVector2D(Bounds.Min.X, Bounds.Max.Y);
-                SegY1 = FVector2D(Bounds.Max.X, Bounds.Max.Y);
+                ID0.X += SgnX;
+                TMaxX += TDeltaX;
+                --StepCountX;
             }
             else
-            {
-                SegY0 = FVector2D(Bounds.Min.X, Bounds.Min.Y);
-                SegY1 = FVector2D(Bounds.Max.X, Bounds.Min.Y);
-            }
-
-            bool bIntersectY = UGULGeometryUtility::SegmentIntersection2D(
-                P0,
-                P1,
-                SegY0,
-                SegY1
-                );
-
-            if (bIntersectY)
             {
                 ID0.Y += SgnY;
-                OutGridIds.Emplace(ID0);
-                continue;
+                TMaxY += TDeltaY;
+                --StepCountY;
             }
 
-            // Fallback check if segment intersection checks
-            // missed the correct final voxel
-            if ((ID0+FIntPoint(-SgnX, 0    )) == ID1 ||
-                (ID0+FIntPoint(    0, -SgnY)) == ID1)
-            {
-                ID0 = ID1;
-                OutGridIds.Emplace(ID0);
-                continue;
-            }
-
-            // Check no entry
-            check(false);
+            OutGridIds.Emplace(ID0);
         }
     }
 
@@ -193,13 +235,89 @@ public:
         TFunction<bool(int32, FIntPoint)> FilterCallback = nullptr
         );
 
+    // Inlined callback variant of GridFillBoundsByPoints(), accepts any
+    // callable with bool(int32, FIntPoint) signature. Null and TFunction
+    // callbacks resolve to the TFunction overload.
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
+    static bool GridFillBoundsByPoints(
+        TArray<FIntPoint>& OutPoints,
+        const TArray<FIntPoint>& InTargetPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        FCallback&& FilterCallback
+        );
+
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
+    static bool GridFillBoundsByPoints(
+        TArray<FIntPoint>& OutPoints,
+        FGULGridScratch& Scratch,
+        const TArray<FIntPoint>& InTargetPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        FCallback&& FilterCallback
+        );
+
+    static void VisitPointsByPredicate(
+        const TArray<FIntPoint>& InTargetPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+        );
+
+    // Inlined callback variant of VisitPointsByPredicate(), accepts any
+    // callable with bool(int32, FIntPoint, int32) signature. Null and
+    // TFunction callbacks resolve to the TFunction overload.
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
     static void VisitPointsByPredicate(
+        const TArray<FIntPoint>& InTargetPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        FCallback&& VisitCallback
+        );
+
+    template<typename FCallback, typename = typename TEnableIf<TGULIsInlineGridCallback<FCallback>::Value>::Type>
+    static void VisitPointsByPredicate(
+        FGULGridScratch& Scratch,
+        const TArray<FIntPoint>& InTargetPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        FCallback&& VisitCallback
+        );
+
+    // Parallel level-synchronous variant of VisitPointsByPredicate().
+    //
+    // Each visit level is expanded on worker threads. The callback may run
+    // concurrently on multiple threads and must be thread-safe. It is invoked
+    // at most once per cell and level, with the level as iteration. Accepted
+    // cells are visited once, rejected cells may be offered again on later
+    // levels.
+    static void VisitPointsByPredicateParallel(
         const TArray<FIntPoint>& InTargetPoints,
         FIntPoint BoundsMin,
         FIntPoint BoundsMax,
         TFunction<bool(int32, FIntPoint, int32)> VisitCallback
         );
 
+    // Generate dense distance field of seed points within inclusive bounds.
+    // Distances are indexed by (X-BoundsMin.X) + (Y-BoundsMin.Y)*Stride.
+    UFUNCTION(BlueprintCallable)
+    static bool GenerateDistanceField(
+        TArray<float>& OutDistances,
+        const TArray<FIntPoint>& SeedPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        EGULGridDistanceMetric Metric = EGULGridDistanceMetric::Euclidean
+        );
+
+    static bool GenerateDistanceFieldUInt16(
+        TArray<uint16>& OutDistances,
+        const TArray<FIntPoint>& SeedPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        EGULGridDistanceMetric Metric = EGULGridDistanceMetric::Euclidean,
+        float DistanceScale = 1.f
+        );
+
     static bool GenerateGridAndEdgeGroupsIntersections(
         TMap<int32, FGULVector2DGroup>& IntersectionMap,
         TArray<FVector2D>& IntersectEdges,
@@ -211,15 +329,137 @@ public:
         float IntersectRadius = KINDA_SMALL_NUMBER
         );
 
+    // Batched GenerateGridAndEdgeGroupsIntersections() over grid cells.
+    //
+    // Edge segments are binned once by the cells they walk through, each
+    // cell then only tests segments binned within its neighbourhood.
+    // Output maps grid id index to intersecting edge segment point pairs,
+    // cells without intersection are omitted.
+    static bool GenerateGridsAndEdgeGroupsIntersections(
+        TMap<int32, FGULVector2DGroup>& OutIntersectionMap,
+        const TArray<FGULVector2DGroup>& InEdgeGroups,
+        const TArray<FIntPoint>& InGridIds,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        float IntersectRadius = KINDA_SMALL_NUMBER
+        );
+
+    // Sort grid ids by curve order keys and remove duplicates
+    static void SortUniqueGridIds(TArray<FIntPoint>& InOutGridIds, EGULGridOrder Order = EGULGridOrder::RowMajor);
+
+    // Generate non-unique grid ids of a single poly ring
+    static void GenerateGridsFromPolyPoints(
+        TArray<FIntPoint>& OutGridIds,
+        TArrayView<const FVector2D> InPolyPoints,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        bool bClosedPolygons,
+        float SparseLength
+        );
+
     static void GenerateGridsFromPolyGroups(
         TArray<FIntPoint>& OutGridIds,
         const TArray<FGULVector2DGroup>& InPolys,
         int32 InGridSizeX,
         int32 InGridSizeY,
         bool bClosedPolygons = true,
+        int32 GridSizePerSegment = 10,
+        EGULGridOrder Order = EGULGridOrder::RowMajor
+        );
+
+    static void GenerateGridsFromPolyGroups(
+        TArray<FIntPoint>& OutGridIds,
+        const FGULPolySoup& InPolySoup,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        bool bClosedPolygons = true,
+        int32 GridSizePerSegment = 10,
+        EGULGridOrder Order = EGULGridOrder::RowMajor
+        );
+
+    static void GenerateGridsFromPolyGroups(
+        FGULSparseGrid& OutGrid,
+        const TArray<FGULVector2DGroup>& InPolys,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        bool bClosedPolygons = true,
         int32 GridSizePerSegment = 10
         );
 
+    // Poly Scan Conversion
+
+    UFUNCTION(BlueprintCallable)
+    static void GenerateCoveredGridsFromPolyGroups(
+        TArray<FIntPoint>& OutGridIds,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    UFUNCTION(BlueprintCallable)
+    static void GenerateCoveredGridsFromIndexedPolyGroups(
+        TArray<FIntPoint>& OutGridIds,
+        const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    static void GenerateCoveredSpansFromPolyGroups(
+        TArray<FGULGridSpan>& OutSpans,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    static void GenerateCoveredSpansFromPolyGroups(
+        FGULGridSpanSet& OutSpanSet,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    static void GenerateCoveredSpansFromIndexedPolyGroups(
+        TArray<FGULGridSpan>& OutSpans,
+        const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    static void GenerateCoveredSpansFromIndexedPolyGroups(
+        FGULGridSpanSet& OutSpanSet,
+        const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY
+        );
+
+    // Poly Signed Distance Field
+
+    UFUNCTION(BlueprintCallable)
+    static bool GenerateSignedDistanceFieldFromPolyGroups(
+        TArray<float>& OutDistances,
+        FIntPoint& OutBoundsMin,
+        FIntPoint& OutBoundsMax,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        float BandWidth
+        );
+
+    UFUNCTION(BlueprintCallable)
+    static bool GenerateSignedDistanceFieldFromIndexedPolyGroups(
+        TArray<float>& OutDistances,
+        FIntPoint& OutBoundsMin,
+        FIntPoint& OutBoundsMax,
+        const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+        const TArray<FGULVector2DGroup>& InPolyGroups,
+        int32 InGridSizeX,
+        int32 InGridSizeY,
+        float BandWidth
+        );
+
     UFUNCTION(BlueprintCallable, meta=(DisplayName="Grid Walk"))
     static void K2_GridWalk(
         TArray<FIntPoint>& OutGridIds,
@@ -248,6 +488,43 @@ public:
         int32 GroupDimensionY
         );
 
+    // Group grid ids by sorting packed 64-bit group keys.
+    //
+    // Groups are ordered by row-major, Morton or Hilbert order of group ids,
+    // grid ids within a group keep their input order.
+    UFUNCTION(BlueprintCallable)
+    static int32 GroupGridsByDimensionSorted(
+        TArray<FIntPoint>& OutGroupIds,
+        TArray<FGULIntPointGroup>& OutGridIdGroups,
+        const TArray<FIntPoint>& InGridIds,
+        int32 GroupDimensionX,
+        int32 GroupDimensionY,
+        EGULGridOrder Order = EGULGridOrder::RowMajor
+        );
+
+    // Group grid ids into contiguous ranges of sorted grid ids.
+    //
+    // Grid ids of group i are OutGridIds[OutGroupOffsets[i], OutGroupOffsets[i+1]).
+    static int32 GroupGridRangesByDimension(
+        TArray<FIntPoint>& OutGroupIds,
+        TArray<int32>& OutGroupOffsets,
+        TArray<FIntPoint>& OutGridIds,
+        const TArray<FIntPoint>& InGridIds,
+        int32 GroupDimensionX,
+        int32 GroupDimensionY,
+        EGULGridOrder Order = EGULGridOrder::RowMajor
+        );
+
+    static int32 GroupGridRangesByDimension(
+        TArray<FIntPoint>& OutGroupIds,
+        TArray<int32>& OutGroupOffsets,
+        TArray<FIntPoint>& OutGridIds,
+        const FGULSparseGrid& InGrid,
+        int32 GroupDimensionX,
+        int32 GroupDimensionY,
+        EGULGridOrder Order = EGULGridOrder::RowMajor
+        );
+
     UFUNCTION(BlueprintCallable)
     static int32 GroupGridsByDimensionAndBounds(
         TArray<FIntPoint>& OutGroupIds,
@@ -263,13 +540,50 @@ public:
     static bool GridFillByPoint(
         TArray<FIntPoint>& OutPoints,
         const TArray<FIntPoint>& BoundaryPoints,
+        const FIntPoint& FillTargetPoint,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
+        );
+
+    // Fill using caller supplied scratch, reuses fill allocations across calls
+    static bool GridFillByPoint(
+        TArray<FIntPoint>& OutPoints,
+        FGULGridScratch& Scratch,
+        const TArray<FIntPoint>& BoundaryPoints,
+        const FIntPoint& FillTargetPoint,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
+        );
+
+    static bool GridFillSparseByPoint(
+        TArray<FIntPoint>& OutPoints,
+        const FGULSparseGrid& BoundaryGrid,
+        const FIntPoint& FillTargetPoint,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
+        );
+
+    static bool GridFillSpansByPoint(
+        TArray<FGULGridSpan>& OutSpans,
+        const TArray<FIntPoint>& BoundaryPoints,
+        const FIntPoint& FillTargetPoint
+        );
+
+    static bool GridFillSpansByPoint(
+        TArray<FGULGridSpan>& OutSpans,
+        FGULGridScratch& Scratch,
+        const TArray<FIntPoint>& BoundaryPoints,
+        const FIntPoint& FillTargetPoint
+        );
+
+    static bool GridFillSpansByPoint(
+        FGULGridSpanSet& OutSpanSet,
+        const TArray<FIntPoint>& BoundaryPoints,
         const FIntPoint& FillTargetPoint
         );
 
     UFUNCTION(BlueprintCallable)
     static bool GenerateIsolatedPointGroups(
         TArray<FGULIntPointGroup>& OutPointGroups,
-        const TArray<FIntPoint>& BoundaryPoints
+        const TArray<FIntPoint>& BoundaryPoints,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
         );
 
     UFUNCTION(BlueprintCallable)
@@ -277,9 +591,54 @@ public:
         TArray<FGULIntPointGroup>& OutPointGroups,
         const TArray<FIntPoint>& BoundaryPoints,
         FIntPoint BoundsMin,
+        FIntPoint BoundsMax,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
+        );
+
+    static bool GenerateIsolatedPointGroupsFromSparseGrid(
+        TArray<FGULIntPointGroup>& OutPointGroups,
+        const FGULSparseGrid& BoundaryGrid,
+        EGULGridFillMode FillMode = EGULGridFillMode::Queue
+        );
+
+    UFUNCTION(BlueprintCallable)
+    static bool GenerateIsolatedComponents(
+        TArray<FGULIntPointGroup>& OutPointGroups,
+        TArray<FGULGridComponent>& OutComponents,
+        const TArray<FIntPoint>& BoundaryPoints
+        );
+
+    UFUNCTION(BlueprintCallable)
+    static bool GenerateIsolatedComponentsWithinBounds(
+        TArray<FGULIntPointGroup>& OutPointGroups,
+        TArray<FGULGridComponent>& OutComponents,
+        const TArray<FIntPoint>& BoundaryPoints,
+        FIntPoint BoundsMin,
         FIntPoint BoundsMax
         );
 
+    static bool GenerateIsolatedSpanGroups(
+        TArray<FGULGridSpanGroup>& OutSpanGroups,
+        const TArray<FIntPoint>& BoundaryPoints
+        );
+
+    static bool GenerateIsolatedSpanGroups(
+        TArray<FGULGridSpanSet>& OutSpanSets,
+        const TArray<FIntPoint>& BoundaryPoints
+        );
+
+    static bool GenerateIsolatedSpanGroupsWithinBounds(
+        TArray<FGULGridSpanGroup>& OutSpanGroups,
+        const TArray<FIntPoint>& BoundaryPoints,
+        FIntPoint BoundsMin,
+        FIntPoint BoundsMax
+        );
+
+    inline static void ConvertSpansToPoints(
+        TArray<FIntPoint>& OutPoints,
+        const TArray<FGULGridSpan>& InSpans
+        );
+
     UFUNCTION(BlueprintCallable)
     static void GenerateIsolatedGridsOnPoly(
         TArray<FIntPoint>& GridIds,
@@ -303,6 +662,8 @@ public:
     FORCEINLINE static bool IsOnBounds(const FIntPoint& Point, const FIntPoint& BoundsMin, const FIntPoint& BoundsMax);
     FORCEINLINE static FIntPoint GetGridId(const FVector2D& Point, int32 DimensionX, int32 DimensionY);
     FORCEINLINE static int32 GetGridIndex(const FIntPoint& Point, const FIntPoint& Origin, int32 Stride);
+    FORCEINLINE static uint64 GetGridOrderKey(const FIntPoint& Point, EGULGridOrder Order);
+    FORCEINLINE static FIntPoint GetGridOrderPoint(uint64 Key, EGULGridOrder Order);
 };
 
 FORCEINLINE FIntPoint UGULGridUtility::GetGridId(const FVector2D& Point, int32 DimensionX, int32 DimensionY)
@@ -319,6 +680,38 @@ FORCEINLINE int32 UGULGridUtility::GetGridIndex(const FIntPoint& Point, const FI
     return (Point.X-Origin.X) + (Point.Y-Origin.Y)*Stride;
 }
 
+FORCEINLINE uint64 UGULGridUtility::GetGridOrderKey(const FIntPoint& Point, EGULGridOrder Order)
+{
+    switch (Order)
+    {
+        case EGULGridOrder::Morton:
+            return UGULMathLibrary::GetMortonKey(Point);
+
+        case EGULGridOrder::Hilbert:
+            return UGULMathLibrary::GetHilbertKey(Point);
+
+        case EGULGridOrder::RowMajor:
+        default:
+            return UGULMathLibrary::PackGridKey(Point);
+    }
+}
+
+FORCEINLINE FIntPoint UGULGridUtility::GetGridOrderPoint(uint64 Key, EGULGridOrder Order)
+{
+    switch (Order)
+    {
+        case EGULGridOrder::Morton:
+            return UGULMathLibrary::GetMortonPoint(Key);
+
+        case EGULGridOrder::Hilbert:
+            return UGULMathLibrary::GetHilbertPoint(Key);
+
+        case EGULGridOrder::RowMajor:
+        default:
+            return UGULMathLibrary::UnpackGridKey(Key);
+    }
+}
+
 FORCEINLINE bool UGULGridUtility::IsOnBounds(const FIntPoint& Point, const FIntPoint& BoundsMin, const FIntPoint& BoundsMax)
 {
     return 
@@ -354,11 +747,23 @@ inline void UGULGridUtility::GenerateBoundaryData(
     Size = GetBoundsStride(BoundsMin, BoundsMax);
 }
 
-inline void UGULGridUtility::GenerateIndexSet(TSet<int32>& OutIndexSet, const TArray<FIntPoint>& InPoints, const FIntPoint& Origin, int32 Stride)
+inline void UGULGridUtility::ConvertSpansToPoints(TArray<FIntPoint>& OutPoints, const TArray<FGULGridSpan>& InSpans)
 {
-    for (const FIntPoint& Point : InPoints)
+    int32 PointCount = 0;
+
+    for (const FGULGridSpan& Span : InSpans)
+    {
+        PointCount += Span.Num();
+    }
+
+    OutPoints.Reset(PointCount);
+
+    for (const FGULGridSpan& Span : InSpans)
     {
-        OutIndexSet.Emplace(GetGridIndex(Point, Origin, Stride));
+        for (int32 x=Span.X0; x<=Span.X1; ++x)
+        {
+            OutPoints.Emplace(x, Span.Y);
+        }
     }
 }
 
@@ -413,3 +818,268 @@ FORCEINLINE_DEBUGGABLE void UGULGridUtility::K2_GenerateGridsFromPolyGroups(
         bClosedPolygons
         );
 }
+
+template<typename FCallback, typename>
+inline void UGULGridUtility::PointFillMulti(
+    TArray<FIntPoint>& OutPoints,
+    FGULGridScratch& Scratch,
+    const FIntPoint& BoundsMin,
+    const FIntPoint& BoundsMax,
+    const TArray<FIntPoint>& TargetPoints,
+    FCallback&& VisitCallback
+    )
+{
+    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
+
+    check(Size > 0);
+
+    FGULGridPointQueue& VisitQueue(Scratch.VisitQueue);
+    FGULGridCellStates& CellStates(Scratch.CellStates);
+
+    VisitQueue.Reset();
+    CellStates.Init(BoundsMin, BoundsMax);
+
+    // Visit target points
+    for (const FIntPoint& TargetPoint : TargetPoints)
+    {
+        if (CellStates.IsOnBounds(TargetPoint))
+        {
+            CellStates.SetVisited(CellStates.GetIndex(TargetPoint));
+            VisitQueue.Enqueue(TargetPoint);
+        }
+    }
+
+    const FIntPoint Offsets[4] = {
+        FIntPoint(-1,  0), // W
+        FIntPoint( 0, -1), // S
+        FIntPoint( 1,  0), // E
+        FIntPoint( 0,  1)  // N
+        };
+
+    // Visit target point neighbours
+    while (! VisitQueue.IsEmpty())
+    {
+        FIntPoint VisitPoint;
+        VisitQueue.Dequeue(VisitPoint);
+
+        for (int32 i=0; i<4; ++i)
+        {
+            FIntPoint NeighbourPoint(VisitPoint+Offsets[i]);
+
+            // Skip out-of-bounds points
+            if (! CellStates.IsOnBounds(NeighbourPoint))
+            {
+                continue;
+            }
+
+            int32 NeighbourIndex = CellStates.GetIndex(NeighbourPoint);
+
+            // Skip visited points
+            if (CellStates.IsVisited(NeighbourIndex))
+            {
+                continue;
+            }
+
+            if (VisitCallback(NeighbourIndex, NeighbourPoint))
+            {
+                // Mark point as visited
+                CellStates.SetVisited(NeighbourIndex);
+                VisitQueue.Enqueue(NeighbourPoint);
+
+                OutPoints.Emplace(NeighbourPoint);
+            }
+        }
+    }
+}
+
+template<typename FCallback, typename>
+inline void UGULGridUtility::VisitPoints(
+    FGULGridScratch& Scratch,
+    const FIntPoint& BoundsMin,
+    const FIntPoint& BoundsMax,
+    const TArray<FIntPoint>& TargetPoints,
+    FCallback&& VisitCallback
+    )
+{
+    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
+
+    check(Size > 0);
+
+    FGULGridPointQueue& VisitQueue0(Scratch.VisitQueue);
+    FGULGridPointQueue& VisitQueue1(Scratch.NextVisitQueue);
+    FGULGridCellStates& CellStates(Scratch.CellStates);
+
+    VisitQueue0.Reset();
+    VisitQueue1.Reset();
+    CellStates.Init(BoundsMin, BoundsMax);
+
+    // Visit target points
+    for (const FIntPoint& TargetPoint : TargetPoints)
+    {
+        if (! CellStates.IsOnBounds(TargetPoint))
+        {
+            continue;
+        }
+
+        int32 TargetIndex = CellStates.GetIndex(TargetPoint);
+
+        if (CellStates.IsVisited(TargetIndex))
+        {
+            continue;
+        }
+
+        if (VisitCallback(TargetIndex, TargetPoint, 0))
+        {
+            // Mark point as visited
+            CellStates.SetVisited(TargetIndex);
+            VisitQueue0.Enqueue(TargetPoint);
+        }
+    }
+
+    const FIntPoint Offsets[4] = {
+        FIntPoint(-1,  0), // W
+        FIntPoint( 0, -1), // S
+        FIntPoint( 1,  0), // E
+        FIntPoint( 0,  1)  // N
+        };
+
+    FGULGridPointQueue* CurVisitQueue(&VisitQueue1);
+    FGULGridPointQueue* NextVisitQueue(&VisitQueue0);
+    int32 Iteration = 1;
+
+    while (! NextVisitQueue->IsEmpty())
+    {
+        Swap(CurVisitQueue, NextVisitQueue);
+
+        // Visit target point neighbours
+        while (! CurVisitQueue->IsEmpty())
+        {
+            FIntPoint VisitPoint;
+            CurVisitQueue->Dequeue(VisitPoint);
+
+            for (int32 i=0; i<4; ++i)
+            {
+                FIntPoint NeighbourPoint(VisitPoint+Offsets[i]);
+
+                // Skip out-of-bounds points
+                if (! CellStates.IsOnBounds(NeighbourPoint))
+                {
+                    continue;
+                }
+
+                int32 NeighbourIndex = CellStates.GetIndex(NeighbourPoint);
+
+                // Skip visited points
+                if (CellStates.IsVisited(NeighbourIndex))
+                {
+                    continue;
+                }
+
+                if (VisitCallback(NeighbourIndex, NeighbourPoint, Iteration))
+                {
+                    // Mark point as visited
+                    CellStates.SetVisited(NeighbourIndex);
+                    NextVisitQueue->Enqueue(NeighbourPoint);
+                }
+            }
+        }
+
+        ++Iteration;
+    }
+}
+
+template<typename FCallback, typename>
+inline bool UGULGridUtility::GridFillBoundsByPoints(
+    TArray<FIntPoint>& OutPoints,
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    FCallback&& FilterCallback
+    )
+{
+    FGULGridScratch Scratch;
+
+    return GridFillBoundsByPoints(
+        OutPoints,
+        Scratch,
+        InTargetPoints,
+        BoundsMin,
+        BoundsMax,
+        Forward<FCallback>(FilterCallback)
+        );
+}
+
+template<typename FCallback, typename>
+inline bool UGULGridUtility::GridFillBoundsByPoints(
+    TArray<FIntPoint>& OutPoints,
+    FGULGridScratch& Scratch,
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    FCallback&& FilterCallback
+    )
+{
+    TArray<FIntPoint> TargetPoints;
+    FilterBoundaryPointsWithinBounds(TargetPoints, BoundsMin, BoundsMax, InTargetPoints);
+
+    if (TargetPoints.Num() < 1)
+    {
+        return false;
+    }
+
+    PointFillMulti(
+        OutPoints,
+        Scratch,
+        BoundsMin,
+        BoundsMax,
+        TargetPoints,
+        Forward<FCallback>(FilterCallback)
+        );
+    
+    return true;
+}
+
+template<typename FCallback, typename>
+inline void UGULGridUtility::VisitPointsByPredicate(
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    FCallback&& VisitCallback
+    )
+{
+    FGULGridScratch Scratch;
+
+    VisitPointsByPredicate(
+        Scratch,
+        InTargetPoints,
+        BoundsMin,
+        BoundsMax,
+        Forward<FCallback>(VisitCallback)
+        );
+}
+
+template<typename FCallback, typename>
+inline void UGULGridUtility::VisitPointsByPredicate(
+    FGULGridScratch& Scratch,
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    FCallback&& VisitCallback
+    )
+{
+    TArray<FIntPoint> TargetPoints;
+    FilterBoundaryPointsWithinBounds(TargetPoints, BoundsMin, BoundsMax, InTargetPoints);
+
+    if (TargetPoints.Num() < 1)
+    {
+        return;
+    }
+
+    VisitPoints(
+        Scratch,
+        BoundsMin,
+        BoundsMax,
+        TargetPoints,
+        Forward<FCallback>(VisitCallback)
+        );
+}
@@ -0,0 +1,305 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Sparse grid cell set of fixed size square chunks.
+//
+// Each chunk holds one 64-bit cell mask per chunk row, chunks are mapped by
+// packed 64-bit chunk keys. Iteration visits chunks in row-major chunk order
+// and cells in row-major order within each chunk.
+class GEOMETRYUTILITYLIBRARY_API FGULSparseGrid
+{
+public:
+
+    enum { ChunkSizeLog2 = 6 };
+    enum { ChunkSize = 1 << ChunkSizeLog2 };
+    enum { ChunkMask = ChunkSize-1 };
+
+    struct FChunk
+    {
+        FIntPoint ChunkId;
+        int32 CellCount = 0;
+        uint64 Rows[ChunkSize];
+
+        FChunk(const FIntPoint& InChunkId)
+            : ChunkId(InChunkId)
+        {
+            FMemory::Memzero(Rows, sizeof(Rows));
+        }
+
+        FORCEINLINE bool IsEmpty() const
+        {
+            return CellCount < 1;
+        }
+    };
+
+private:
+
+    TArray<FChunk> Chunks;
+    TMap<uint64, int32> ChunkMap;
+    int32 CellCount = 0;
+
+    FChunk& FindOrAddChunk(const FIntPoint& ChunkId);
+    const FChunk* FindChunk(const FIntPoint& ChunkId) const;
+
+public:
+
+    FGULSparseGrid() = default;
+
+    explicit FGULSparseGrid(const TArray<FIntPoint>& Points)
+    {
+        Append(Points);
+    }
+
+    // Arithmetic shift and mask floor negative coordinates into chunk space
+
+    FORCEINLINE static FIntPoint GetChunkId(const FIntPoint& Point)
+    {
+        return FIntPoint(Point.X >> ChunkSizeLog2, Point.Y >> ChunkSizeLog2);
+    }
+
+    FORCEINLINE static FIntPoint GetChunkLocalPoint(const FIntPoint& Point)
+    {
+        return FIntPoint(Point.X & ChunkMask, Point.Y & ChunkMask);
+    }
+
+    FORCEINLINE static FIntPoint GetChunkOrigin(const FIntPoint& ChunkId)
+    {
+        return FIntPoint(ChunkId.X * ChunkSize, ChunkId.Y * ChunkSize);
+    }
+
+    FORCEINLINE static int32 CountTrailingZeros(uint64 Bits)
+    {
+        const uint32 LowBits = static_cast<uint32>(Bits);
+        return LowBits
+            ? FMath::CountTrailingZeros(LowBits)
+            : 32 + FMath::CountTrailingZeros(static_cast<uint32>(Bits >> 32));
+    }
+
+    FORCEINLINE static int32 FloorLog2(uint64 Bits)
+    {
+        const uint32 HighBits = static_cast<uint32>(Bits >> 32);
+        return HighBits
+            ? 32 + FMath::FloorLog2(HighBits)
+            : FMath::FloorLog2(static_cast<uint32>(Bits));
+    }
+
+    void Reset();
+
+    FORCEINLINE int32 Num() const
+    {
+        return CellCount;
+    }
+
+    FORCEINLINE bool IsEmpty() const
+    {
+        return CellCount < 1;
+    }
+
+    FORCEINLINE int32 GetChunkNum() const
+    {
+        return Chunks.Num();
+    }
+
+    FORCEINLINE const TArray<FChunk>& GetChunks() const
+    {
+        return Chunks;
+    }
+
+    bool Contains(const FIntPoint& Point) const;
+
+    // Add cell, returns true if the cell was not already in the set
+    bool Add(const FIntPoint& Point);
+
+    // Grid container interface, allows use as GridWalk() output
+    FORCEINLINE void Emplace(const FIntPoint& Point)
+    {
+        Add(Point);
+    }
+
+    // Remove cell, returns true if the cell was in the set
+    bool Remove(const FIntPoint& Point);
+
+    void Append(TArrayView<const FIntPoint> Points);
+
+    FORCEINLINE void Append(const TArray<FIntPoint>& Points)
+    {
+        Append(TArrayView<const FIntPoint>(Points));
+    }
+
+    // Union with other sparse grid
+    void Append(const FGULSparseGrid& Other);
+
+    // Inclusive cell bounds, returns false on empty set
+    bool GetBounds(FIntPoint& OutBoundsMin, FIntPoint& OutBoundsMax) const;
+
+    // Chunk indices sorted by row-major chunk order
+    void GetSortedChunkIndices(TArray<int32>& OutChunkIndices) const;
+
+    void ForEach(TFunctionRef<void(const FIntPoint&)> Callback) const;
+
+    void ToPoints(TArray<FIntPoint>& OutPoints) const;
+
+    FORCEINLINE TArray<FIntPoint> ToPoints() const
+    {
+        TArray<FIntPoint> Points;
+        ToPoints(Points);
+        return Points;
+    }
+};
+
+// Sparse grid cell states over the inclusive bounds of a boundary sparse grid.
+//
+// Provides the grid index interface of FGULGridCellStates without a dense
+// allocation over the whole bounds. Boundary states are read from the
+// boundary grid chunks, visited states are stored in chunks allocated on
+// first visit. Grid indices use a power of two row stride.
+class GEOMETRYUTILITYLIBRARY_API FGULGridSparseCellStates
+{
+    struct FVisitedChunk
+    {
+        uint64 Rows[FGULSparseGrid::ChunkSize];
+
+        FVisitedChunk()
+        {
+            FMemory::Memzero(Rows, sizeof(Rows));
+        }
+    };
+
+    const FGULSparseGrid* BoundaryGrid = nullptr;
+
+    FIntPoint BoundsMin = FIntPoint::ZeroValue;
+    FIntPoint BoundsMax = FIntPoint(-1, -1);
+    int32 StrideLog2 = 0;
+    int32 Stride = 0;
+
+    // Chunk slot tables over the bounds chunk range, map chunk slots to
+    // boundary grid chunk and visited chunk indices
+    FIntPoint ChunkMin = FIntPoint::ZeroValue;
+    int32 ChunkCountX = 0;
+    TArray<int32> BoundaryChunkIndices;
+    TArray<int32> VisitedChunkIndices;
+    TArray<FVisitedChunk> VisitedChunks;
+
+    FORCEINLINE int32 GetChunkSlot(const FIntPoint& Point) const
+    {
+        const FIntPoint ChunkId(FGULSparseGrid::GetChunkId(Point));
+        return (ChunkId.X-ChunkMin.X) + (ChunkId.Y-ChunkMin.Y)*ChunkCountX;
+    }
+
+    FORCEINLINE uint64& FindOrAddVisitedRow(const FIntPoint& Point)
+    {
+        int32& ChunkIndex(VisitedChunkIndices[GetChunkSlot(Point)]);
+
+        if (ChunkIndex == INDEX_NONE)
+        {
+            ChunkIndex = VisitedChunks.AddDefaulted();
+        }
+
+        return VisitedChunks[ChunkIndex].Rows[Point.Y & FGULSparseGrid::ChunkMask];
+    }
+
+public:
+
+    // Init states with boundary grid cells as boundary, the boundary grid
+    // must outlive the states. Returns false on empty boundary grid.
+    bool Init(const FGULSparseGrid& InBoundaryGrid);
+
+    FORCEINLINE const FIntPoint& GetBoundsMin() const
+    {
+        return BoundsMin;
+    }
+
+    FORCEINLINE const FIntPoint& GetBoundsMax() const
+    {
+        return BoundsMax;
+    }
+
+    FORCEINLINE int32 GetStride() const
+    {
+        return Stride;
+    }
+
+    FORCEINLINE int32 GetVisitedChunkNum() const
+    {
+        return VisitedChunks.Num();
+    }
+
+    FORCEINLINE bool IsOnBounds(const FIntPoint& Point) const
+    {
+        return
+            Point.X >= BoundsMin.X && Point.Y >= BoundsMin.Y &&
+            Point.X <= BoundsMax.X && Point.Y <= BoundsMax.Y;
+    }
+
+    FORCEINLINE int32 GetIndex(const FIntPoint& Point) const
+    {
+        return (Point.X-BoundsMin.X) + ((Point.Y-BoundsMin.Y) << StrideLog2);
+    }
+
+    FORCEINLINE FIntPoint GetPoint(int32 Index) const
+    {
+        return FIntPoint(BoundsMin.X + (Index & (Stride-1)), BoundsMin.Y + (Index >> StrideLog2));
+    }
+
+    // Cell state access by grid index
+
+    FORCEINLINE bool IsBoundary(int32 Index) const
+    {
+        const FIntPoint Point(GetPoint(Index));
+        const int32 ChunkIndex = BoundaryChunkIndices[GetChunkSlot(Point)];
+
+        return ChunkIndex != INDEX_NONE &&
+            (BoundaryGrid->GetChunks()[ChunkIndex].Rows[Point.Y & FGULSparseGrid::ChunkMask] >> (Point.X & FGULSparseGrid::ChunkMask)) & 1;
+    }
+
+    FORCEINLINE bool IsVisited(int32 Index) const
+    {
+        const FIntPoint Point(GetPoint(Index));
+        const int32 ChunkIndex = VisitedChunkIndices[GetChunkSlot(Point)];
+
+        return ChunkIndex != INDEX_NONE &&
+            (VisitedChunks[ChunkIndex].Rows[Point.Y & FGULSparseGrid::ChunkMask] >> (Point.X & FGULSparseGrid::ChunkMask)) & 1;
+    }
+
+    FORCEINLINE bool IsBoundaryOrVisited(int32 Index) const
+    {
+        return IsBoundary(Index) || IsVisited(Index);
+    }
+
+    FORCEINLINE void SetVisited(int32 Index)
+    {
+        const FIntPoint Point(GetPoint(Index));
+        FindOrAddVisitedRow(Point) |= 1ull << (Point.X & FGULSparseGrid::ChunkMask);
+    }
+
+    // Mark consecutive cells of a single row as visited
+    void SetVisitedRange(int32 Index, int32 Count);
+};
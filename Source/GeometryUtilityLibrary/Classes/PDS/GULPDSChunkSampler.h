@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PDS/GULPoissonDiscChunkSampler.h"
+#include "GULPDSChunkSampler.generated.h"
+
+// Persistent streaming Poisson disc chunk sampler.
+//
+// Keeps FGULPoissonDiscChunkSampler border cache alive across calls, so
+// each chunk only generates its uncached lower phase neighbours once.
+UCLASS(BlueprintType)
+class GEOMETRYUTILITYLIBRARY_API UGULPDSChunkSampler : public UObject
+{
+    GENERATED_BODY()
+
+    TUniquePtr<FGULPoissonDiscChunkSampler> Sampler;
+
+public:
+
+    // Set sampler configuration, clears cached chunk border points
+    UFUNCTION(BlueprintCallable)
+    void Initialize(float ChunkSize, int32 RandomSeed = 1337, float PointRadius = 1.f, int32 KValue = 25);
+
+    UFUNCTION(BlueprintCallable)
+    bool HasValidConfig() const;
+
+    // Generate chunk points, chunk bounds are half-open [Min, Max)
+    UFUNCTION(BlueprintCallable)
+    void GeneratePoints(TArray<FVector2D>& OutPoints, FIntPoint ChunkId);
+
+    UFUNCTION(BlueprintCallable)
+    FIntPoint GetChunkId(FVector2D Point) const;
+
+    UFUNCTION(BlueprintCallable)
+    FBox2D GetChunkBounds(FIntPoint ChunkId) const;
+
+    UFUNCTION(BlueprintCallable)
+    int32 GetCachedChunkNum() const;
+
+    UFUNCTION(BlueprintCallable)
+    void ResetCache();
+};
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PDS/GULPoissonDiscTileSet.h"
+#include "GULPDSTileSet.generated.h"
+
+// Persistent Poisson disc Wang tile set.
+//
+// Keeps a built FGULPoissonDiscTileSet alive across calls, so tiles are only
+// sampled once on initialization and each region lookup is a tile copy.
+UCLASS(BlueprintType)
+class GEOMETRYUTILITYLIBRARY_API UGULPDSTileSet : public UObject
+{
+    GENERATED_BODY()
+
+    TUniquePtr<FGULPoissonDiscTileSet> TileSet;
+
+public:
+
+    // Build tile set, tile size is in point radius units
+    UFUNCTION(BlueprintCallable)
+    void Initialize(int32 RandomSeed = 1337, float TileSize = 10.f, int32 EdgeColorCount = 2, int32 InteriorVariantCount = 2, int32 KValue = 25);
+
+    UFUNCTION(BlueprintCallable)
+    bool HasValidTileSet() const;
+
+    // Generate points within half-open bounds with an absolute point radius
+    UFUNCTION(BlueprintCallable)
+    void GeneratePoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed = 1337, float PointRadius = 1.f) const;
+
+    UFUNCTION(BlueprintCallable)
+    float GetTileSize() const;
+
+    UFUNCTION(BlueprintCallable)
+    int32 GetTileNum() const;
+};
@@ -29,6 +29,7 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Poly/GULPolyTypes.h"
 #include "GULPDSUtility.generated.h"
 
 UCLASS()
@@ -40,4 +41,21 @@ public:
 
     UFUNCTION(BlueprintCallable)
     static void GeneratePoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed = 1337, float PointRadius = .1f, int32 KValue = 25);
+
+    UFUNCTION(BlueprintCallable)
+    static void GeneratePointsParallel(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed = 1337, float PointRadius = .1f, int32 KValue = 25, int32 TileCellSize = 32);
+
+    // Generate points within poly groups clipped to bounds, point radius
+    // is relative to bounds size
+    UFUNCTION(BlueprintCallable)
+    static void GeneratePolyGroupPoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, const TArray<FGULIndexedPolyGroup>& IndexGroups, const TArray<FGULVector2DGroup>& PolyGroups, int32 RandomSeed = 1337, float PointRadius = .1f, int32 KValue = 25);
+
+    // Generate points of a single streaming chunk with an absolute point
+    // radius, see FGULPoissonDiscChunkSampler. Each call uses a new sampler
+    // without cached border points and recursively regenerates the lower
+    // phase neighbours of the chunk. A phase 3 chunk depends on 16 neighbour
+    // chunks spanning 7x3 chunks (7 along X, 3 along Y). Use
+    // UGULPDSChunkSampler to keep border points cached across calls.
+    UFUNCTION(BlueprintCallable)
+    static void GenerateChunkPoints(TArray<FVector2D>& OutPoints, FIntPoint ChunkId, float ChunkSize, int32 RandomSeed = 1337, float PointRadius = 1.f, int32 KValue = 25);
 };
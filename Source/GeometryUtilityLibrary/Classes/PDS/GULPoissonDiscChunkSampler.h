@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Deterministic streaming Poisson disc sampler over square chunks.
+//
+// Chunks are assigned to 2x2 phase groups by chunk id parity, adjacent chunks
+// never share a phase. A chunk is sampled with a random stream seeded by its
+// chunk id, constrained by the border points of its lower phase neighbours.
+// Chunk points only depend on the random seed and chunk id, regardless of
+// chunk generation order, and never violate the radius across chunk borders.
+//
+// Border points of generated chunks are cached, generating a chunk first
+// generates any uncached lower phase neighbours.
+class GEOMETRYUTILITYLIBRARY_API FGULPoissonDiscChunkSampler
+{
+    FVector2D Origin;
+    float ChunkSize;
+    float PointRadius;
+    int32 RandomSeed;
+    int32 KValue;
+
+    TMap<FIntPoint, TArray<FVector2D>> BorderCache;
+
+    void GenerateChunk(TArray<FVector2D>& OutPoints, const FIntPoint& ChunkId) const;
+    void CacheBorderPoints(const FIntPoint& ChunkId, const TArray<FVector2D>& Points);
+    void GenerateNeighbourBorderPoints(const FIntPoint& ChunkId);
+
+public:
+
+    FGULPoissonDiscChunkSampler(
+        float InChunkSize,
+        float InPointRadius,
+        int32 InRandomSeed = 1337,
+        int32 InKValue = 25,
+        const FVector2D& InOrigin = FVector2D::ZeroVector
+        );
+
+    // Chunks must be at least one radius wide so that samples only
+    // interact with adjacent chunks
+    FORCEINLINE bool HasValidConfig() const
+    {
+        return PointRadius > 0.f
+            && ChunkSize >= PointRadius
+            && KValue > 0;
+    }
+
+    FORCEINLINE static int32 GetChunkPhase(const FIntPoint& ChunkId)
+    {
+        return (ChunkId.X & 1) + (ChunkId.Y & 1)*2;
+    }
+
+    FORCEINLINE FIntPoint GetChunkId(const FVector2D& Point) const
+    {
+        return FIntPoint(
+            FMath::FloorToInt((Point.X-Origin.X) / ChunkSize),
+            FMath::FloorToInt((Point.Y-Origin.Y) / ChunkSize)
+            );
+    }
+
+    FORCEINLINE FBox2D GetChunkBounds(const FIntPoint& ChunkId) const
+    {
+        return FBox2D(
+            Origin + FVector2D(ChunkId.X, ChunkId.Y) * ChunkSize,
+            Origin + FVector2D(ChunkId.X+1, ChunkId.Y+1) * ChunkSize
+            );
+    }
+
+    FORCEINLINE int32 GetCachedChunkNum() const
+    {
+        return BorderCache.Num();
+    }
+
+    void ResetCache();
+
+    // Generate chunk points, chunk bounds are half-open [Min, Max)
+    void GeneratePoints(TArray<FVector2D>& OutPoints, const FIntPoint& ChunkId);
+};
@@ -29,11 +29,26 @@
 
 #include "CoreMinimal.h"
 
+struct FGULIndexedPolyGroup;
+struct FGULVector2DGroup;
+
+enum class EGULPoissonDiscGridMode : uint8
+{
+    // Grid cells store sample indices into the sample point array
+    Indexed,
+
+    // Grid cells store sample positions inline. Empty cells hold a far
+    // sentinel position and the grid is padded by the 2 cell test window,
+    // neighbour tests are branch free contiguous row reads.
+    Inline
+};
+
 class GEOMETRYUTILITYLIBRARY_API FGULPoissonDiscSampler
 {
     float PointRadius;
     FBox2D Bounds;
     int32 KValue;
+    EGULPoissonDiscGridMode GridMode = EGULPoissonDiscGridMode::Inline;
 
     float RadiusSq;
     float CellSize;
@@ -44,6 +59,17 @@ class GEOMETRYUTILITYLIBRARY_API FGULPoissonDiscSampler
 
     TArray<int32> Grid;
 
+    // Inline mode padded sample position grid
+    TArray<FVector2D> CellPoints;
+    int32 CellStride;
+
+    enum { CellPadding = 2 };
+
+    FORCEINLINE int32 GetCellPointIndex(int32 X, int32 Y) const
+    {
+        return (X+CellPadding) + (Y+CellPadding)*CellStride;
+    }
+
     FORCEINLINE int32 GetIndex(int32 X, int32 Y) const
     {
         return X + Y*DimX;
@@ -73,7 +99,24 @@ class GEOMETRYUTILITYLIBRARY_API FGULPoissonDiscSampler
         Grid[GetIndex(X, Y)] = CellIndex;
     }
 
+    FORCEINLINE void SetSamplePoint(const FIntPoint& Cell, const FVector2D& Point)
+    {
+        check(Cell.X >= 0 && Cell.X < DimX && Cell.Y >= 0 && Cell.Y < DimY);
+        CellPoints[GetCellPointIndex(Cell.X, Cell.Y)] = Point;
+    }
+
+    void InitGrid(bool bInlineGrid);
+
+    // Sample tile cells [CellMin, CellMax] on the inline grid
+    void SampleTile(
+        TArray<FVector2D>& OutPoints,
+        const FIntPoint& CellMin,
+        const FIntPoint& CellMax,
+        FRandomStream& Rand
+        );
+
     bool IsWithinValidPointRadius(const FVector2D& Point, const TArray<FVector2D>& Points) const;
+    bool IsWithinValidPointRadiusInline(const FVector2D& Point) const;
 
 public:
 
@@ -83,6 +126,22 @@ public:
 
     void SetConfig(FBox2D InBounds, float InRadius = 1.f, int32 InKValue = 25);
 
+    FORCEINLINE void SetGridMode(EGULPoissonDiscGridMode InGridMode)
+    {
+        GridMode = InGridMode;
+    }
+
+    FORCEINLINE EGULPoissonDiscGridMode GetGridMode() const
+    {
+        return GridMode;
+    }
+
+    // Override point radius with an absolute radius
+    FORCEINLINE void SetPointRadius(float InPointRadius)
+    {
+        PointRadius = InPointRadius;
+    }
+
     FORCEINLINE bool HasValidConfig() const
     {
         return Bounds.bIsValid
@@ -97,4 +156,26 @@ public:
         FRandomStream Rand(RandomSeed);
         GeneratePoints(OutPoints, Rand);
     }
+
+    // Sample bounds on the inline grid around fixed border points. Border
+    // points outside bounds are kept as sampling constraints and growth
+    // seeds, border points are not part of the output.
+    void GeneratePoints(TArray<FVector2D>& OutPoints, FRandomStream& Rand, TArrayView<const FVector2D> BorderPoints);
+
+    // Sample poly groups (outer poly with holes) clipped to bounds on the
+    // inline grid. Grid cells are rasterized into outside, inside and poly
+    // edge cells, only inside and edge cells are seeded. Candidates on
+    // inside cells are accepted by mask lookup, candidates on edge cells
+    // are tested exactly against the poly groups.
+    void GeneratePoints(
+        TArray<FVector2D>& OutPoints,
+        FRandomStream& Rand,
+        const TArray<FGULIndexedPolyGroup>& IndexGroups,
+        const TArray<FGULVector2DGroup>& PolyGroups
+        );
+
+    // Parallel tiled sampling on the inline grid. Bounds are partitioned into
+    // square tiles of TileCellSize grid cells, sampled in 2x2 phase groups
+    // with per tile random streams. Output only depends on the random seed.
+    void GeneratePointsParallel(TArray<FVector2D>& OutPoints, int32 RandomSeed, int32 TileCellSize = 32);
 };
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Precomputed Poisson disc Wang tile set.
+//
+// Tiles are generated once at unit point radius and scaled on lookup, so a
+// single tile set serves any point radius. Tile edges have one of several
+// colours while all tile corners share a single corner patch. Edge bands
+// are sampled around the corner patches, tile interiors are then sampled
+// around the bands and corner patches of their four edges.
+//
+// Bands and corner patches are shared by all tiles meeting at them and
+// interiors of adjacent tiles are separated by the band width, so any edge
+// colour arrangement is free of radius violations. Sampling a region is a
+// seeded edge colour lookup per tile plus bounds clipping.
+class GEOMETRYUTILITYLIBRARY_API FGULPoissonDiscTileSet
+{
+    float TileSize;
+    int32 EdgeColorCount;
+    int32 InteriorVariantCount;
+
+    TArray<TArray<FVector2D>> Tiles;
+
+    static uint32 GetHash(int32 A, int32 B, int32 C, int32 Seed);
+
+    FORCEINLINE int32 GetTileIndex(int32 S, int32 N, int32 W, int32 E, int32 Variant) const
+    {
+        return (((S*EdgeColorCount + N)*EdgeColorCount + W)*EdgeColorCount + E)*InteriorVariantCount + Variant;
+    }
+
+    void Build(int32 RandomSeed, int32 KValue);
+
+public:
+
+    // Tile size is in point radius units
+    FGULPoissonDiscTileSet(
+        int32 InRandomSeed = 1337,
+        float InTileSize = 10.f,
+        int32 InEdgeColorCount = 2,
+        int32 InInteriorVariantCount = 2,
+        int32 InKValue = 25
+        );
+
+    FORCEINLINE float GetTileSize() const
+    {
+        return TileSize;
+    }
+
+    FORCEINLINE int32 GetTileNum() const
+    {
+        return Tiles.Num();
+    }
+
+    // Tile points on [0, TileSize) at unit point radius
+    FORCEINLINE const TArray<FVector2D>& GetTilePoints(int32 TileIndex) const
+    {
+        return Tiles[TileIndex];
+    }
+
+    // Generate points within half-open bounds. Tiles are aligned to the
+    // world origin, random seed selects edge colours and interior variants.
+    void GeneratePoints(
+        TArray<FVector2D>& OutPoints,
+        const FBox2D& Bounds,
+        float PointRadius,
+        int32 RandomSeed
+        ) const;
+};
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+#include "Poly/GULPolyTypes.h"
+#include "Poly/GULPolySoup.h"
+#include "Poly/GULPreparedPoly.h"
+
+// Even-odd poly hierarchy builder.
+//
+// Positive (outer) polys are registered into a uniform bin grid over their
+// quantized bounds. Containment queries only test the outer polys whose bin
+// covers the query point, using prepared polys for the point-in-poly tests.
+//
+// Each inner poly is assigned to its smallest area containing outer poly in
+// a single sweep. Output is identical to the brute-force all-pairs hierarchy
+// grouping for properly nested polys. Overlapping outer polys may differ,
+// the brute-force grouping decides outer poly nesting by testing the outer
+// poly first point only.
+class GEOMETRYUTILITYLIBRARY_API FGULPolyHierarchyBuilder
+{
+public:
+
+    typedef TArrayView<const FVector2D> FRingView;
+
+private:
+
+    TArray<FRingView> Rings;
+    TArray<int32> CandidateIndices;
+    TArray<int32> Orientations;
+    TArray<float> OuterAreas;
+    TArray<FGULPreparedPoly> PreparedPolys;
+
+    // Outer poly bin grid, bin poly indices are sorted in ascending order
+
+    FIntPoint BinOrigin;
+    FIntPoint BinSize;
+    FIntPoint BinDim;
+
+    TArray<int32> BinOffsets;
+    TArray<int32> BinPolyIndices;
+
+    void PrepareOuterPolys();
+    void GenerateBinGrid();
+
+    TArrayView<const int32> FindCandidateOuterPolys(const FIntPoint& ScaledPoint) const;
+
+public:
+
+    FGULPolyHierarchyBuilder() = default;
+
+    explicit FGULPolyHierarchyBuilder(const TArray<FGULVector2DGroup>& PolyGroups);
+
+    explicit FGULPolyHierarchyBuilder(const FGULPolySoup& PolySoup);
+
+    void SetRings(const TArray<FGULVector2DGroup>& PolyGroups);
+
+    void SetRings(const FGULPolySoup& PolySoup);
+
+    void GroupPolyHierarchyEvenOdd(TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups);
+};
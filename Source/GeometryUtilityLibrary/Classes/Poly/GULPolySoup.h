@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+
+// Flat poly ring container.
+//
+// Ring points are stored in a single contiguous point buffer, ring i spans
+// points [RingOffsets[i], RingOffsets[i+1]). Per-ring bounds and area may be
+// cached on demand with UpdateRingCache().
+struct GEOMETRYUTILITYLIBRARY_API FGULPolySoup
+{
+    typedef TArrayView<const FVector2D> FRingView;
+
+    TArray<FVector2D> Points;
+    TArray<int32> RingOffsets;
+
+    // Optional per-ring cache, empty if not generated
+    TArray<FBox2D> RingBounds;
+    TArray<float> RingAreas;
+
+    FGULPolySoup() = default;
+
+    explicit FGULPolySoup(const TArray<FGULVector2DGroup>& PolyGroups)
+    {
+        FromGroups(PolyGroups);
+    }
+
+    void Reset(int32 RingCount = 0, int32 PointCount = 0);
+
+    void Reserve(int32 RingCount, int32 PointCount);
+
+    FORCEINLINE int32 GetRingNum() const
+    {
+        return FMath::Max(RingOffsets.Num()-1, 0);
+    }
+
+    FORCEINLINE int32 GetPointNum() const
+    {
+        return Points.Num();
+    }
+
+    FORCEINLINE bool IsValidRingIndex(int32 RingIndex) const
+    {
+        return RingIndex >= 0 && RingIndex < GetRingNum();
+    }
+
+    FORCEINLINE int32 GetRingPointNum(int32 RingIndex) const
+    {
+        return RingOffsets[RingIndex+1]-RingOffsets[RingIndex];
+    }
+
+    FORCEINLINE FRingView GetRing(int32 RingIndex) const
+    {
+        return FRingView(Points.GetData()+RingOffsets[RingIndex], GetRingPointNum(RingIndex));
+    }
+
+    // Mutable ring points, invalidates ring cache
+    FORCEINLINE TArrayView<FVector2D> GetMutableRing(int32 RingIndex)
+    {
+        ClearRingCache();
+        return TArrayView<FVector2D>(Points.GetData()+RingOffsets[RingIndex], GetRingPointNum(RingIndex));
+    }
+
+    // Reverse ring point order, keeps ring cache valid
+    void ReverseRing(int32 RingIndex);
+
+    int32 AddRing(FRingView RingPoints);
+
+    TArrayView<FVector2D> AddRingUninitialized(int32 PointCount);
+
+    void GetRings(TArray<FRingView>& OutRings) const;
+
+    // Per-ring cache
+
+    void UpdateRingCache();
+
+    void ClearRingCache();
+
+    FORCEINLINE bool HasRingCache() const
+    {
+        return RingBounds.Num() == GetRingNum() && RingAreas.Num() == GetRingNum();
+    }
+
+    // Poly group conversion
+
+    void FromGroups(const TArray<FGULVector2DGroup>& PolyGroups);
+
+    void ToGroups(TArray<FGULVector2DGroup>& OutPolyGroups) const;
+
+    void ToGroup(FGULVector2DGroup& OutPolyGroup, int32 RingIndex) const;
+};
@@ -31,6 +31,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "GULTypes.h"
 #include "Poly/GULPolyTypes.h"
+#include "Poly/GULPolySoup.h"
 #include "GULPolyUtilityLibrary.generated.h"
 
 USTRUCT(BlueprintType)
@@ -84,6 +85,15 @@ class GEOMETRYUTILITYLIBRARY_API UGULPolyUtilityLibrary : public UBlueprintFunct
     static void CollapseOrMergePointNodeFromSet(FPointList& PointList, FPointNodeSet& PointNodeSet, FPointNode& PointNode, bool bCircular, TArray<FPointNode*>* RemovedNodeNeighbours = nullptr);
     static void GetAdjacentNodes(FPointNode*& PrevNode, FPointNode*& NextNode, FPointList& PointList, FPointNode& Node, bool bCircular, bool bSkipCircularEndPoints);
 
+    // Clip poly using the specified point containers as clip buffers,
+    // clip result is stored in ClipPoints1
+    static void ClipBoundsImpl(
+        TArray<FVector2D>& ClipPoints0,
+        TArray<FVector2D>& ClipPoints1,
+        TArrayView<const FVector2D> InPoints,
+        const FBox2D& InBounds
+        );
+
 public:
 
     UFUNCTION(BlueprintCallable, meta=(DisplayName="Get Area"))
@@ -142,6 +152,7 @@ public:
     // Points Utility
 
     inline static FBox2D GetPointsBounds(const TArray<FVector2D>& Points);
+    inline static FBox2D GetPointsBounds(TArrayView<const FVector2D> Points);
     inline static FBox2D GetPolyGroupsBounds(const TArray<FGULVector2DGroup>& PolyGroups);
 
     static void FitPoints(TArray<FVector2D>& Points, const FVector2D& Dimension, float FitScale = 1.f);
@@ -198,6 +209,8 @@ public:
 
     inline static float GetArea(const TArray<FVector2D>& Points);
 
+    inline static float GetArea(TArrayView<const FVector2D> Points);
+
     FORCEINLINE static float GetArea(
         const FVector2D& Point0,
         const FVector2D& Point1,
@@ -206,6 +219,8 @@ public:
 
     FORCEINLINE static bool GetOrientation(const TArray<FVector2D>& Points);
 
+    FORCEINLINE static bool GetOrientation(TArrayView<const FVector2D> Points);
+
     FORCEINLINE static bool GetOrientation(
         const FVector2D& Point0,
         const FVector2D& Point1,
@@ -232,6 +247,14 @@ public:
         bool bClosePolygonOutput = false
         );
 
+    static void SubdividePolylinesWithinLength(
+        TArray<FVector2D>& OutPoints,
+        TArrayView<const FVector2D> InPoints,
+        float SubdivisionLength = 10.f,
+        bool bClosePolygon = false,
+        bool bClosePolygonOutput = false
+        );
+
     static void GenerateSortedBoundaryEdgeGroups(
         TArray<uint32>& OutIndices,
         TArray<int32>& OutCounts,
@@ -278,11 +301,18 @@ public:
 
     static void FixOrientations(TArray<FGULVector2DGroup>& InOutPolyGroups);
 
+    static void FixOrientations(FGULPolySoup& InOutPolySoup);
+
     static void GroupPolyHierarchyEvenOdd(
         TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups,
         const TArray<FGULVector2DGroup>& PolyGroups
         );
 
+    static void GroupPolyHierarchyEvenOdd(
+        TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups,
+        const FGULPolySoup& PolySoup
+        );
+
     static void ConvertIndexedPolyGroupToVectorGroup(
         FGULVectorGroup& OutVectorGroup,
         const FGULIndexedPolyGroup& InIndexedPolyGroup,
@@ -294,7 +324,7 @@ public:
 
     static void ClipBounds(
         TArray<FVector2D>& OutPoints,
-        const TArray<FVector2D>& InPoints,
+        TArrayView<const FVector2D> InPoints,
         const FBox2D& InBounds
         );
 
@@ -303,6 +333,13 @@ public:
         const TArray<FGULVector2DGroup>& InPolyGroups,
         const FBox2D& InBounds
         );
+
+    // Output soup may be the input soup, which is then clipped in place
+    static void ClipBounds(
+        FGULPolySoup& OutPolySoup,
+        const FGULPolySoup& InPolySoup,
+        const FBox2D& InBounds
+        );
 };
 
 FORCEINLINE_DEBUGGABLE float UGULPolyUtilityLibrary::K2_GetArea(const TArray<FVector2D>& Points)
@@ -386,6 +423,11 @@ FORCEINLINE_DEBUGGABLE void UGULPolyUtilityLibrary::K2_ConvertIndexedPolyGroupTo
 // Points Utility
 
 inline FBox2D UGULPolyUtilityLibrary::GetPointsBounds(const TArray<FVector2D>& Points)
+{
+    return GetPointsBounds(TArrayView<const FVector2D>(Points));
+}
+
+inline FBox2D UGULPolyUtilityLibrary::GetPointsBounds(TArrayView<const FVector2D> Points)
 {
     FBox2D Bounds(ForceInitToZero);
 
@@ -475,6 +517,11 @@ FORCEINLINE bool UGULPolyUtilityLibrary::IsPointOnTri(
 // Find Area and Orientation
 
 inline float UGULPolyUtilityLibrary::GetArea(const TArray<FVector2D>& Points)
+{
+    return GetArea(TArrayView<const FVector2D>(Points));
+}
+
+inline float UGULPolyUtilityLibrary::GetArea(TArrayView<const FVector2D> Points)
 {
     int32 PointCount = Points.Num();
     
@@ -512,6 +559,11 @@ FORCEINLINE bool UGULPolyUtilityLibrary::GetOrientation(const TArray<FVector2D>&
     return GetArea(Points) >= 0.f;
 }
 
+FORCEINLINE bool UGULPolyUtilityLibrary::GetOrientation(TArrayView<const FVector2D> Points)
+{
+    return GetArea(Points) >= 0.f;
+}
+
 FORCEINLINE bool UGULPolyUtilityLibrary::GetOrientation(
     const FVector2D& Point0,
     const FVector2D& Point1,
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GULTypes.h"
+#include "GULMathLibrary.h"
+#include "Poly/GULPolyTypes.h"
+
+// Polygon prepared for repeated point-in-polygon queries.
+//
+// Quantized polygon edges are cached and bucketed by scanline bins so that
+// each query only tests the edges overlapping the query point scanline.
+// Query results are identical to UGULPolyUtilityLibrary::IsPointOnPoly().
+class GEOMETRYUTILITYLIBRARY_API FGULPreparedPoly
+{
+public:
+
+    struct FEdge
+    {
+        FIntPoint P0;
+        FIntPoint P1;
+    };
+
+private:
+
+    // Edges sorted by scanline bins, an edge is duplicated
+    // for each bin overlapped by its vertical extents
+    TArray<FEdge> BinEdges;
+    TArray<int32> BinOffsets;
+
+    int32 BinCount = 0;
+    int32 BinHeight = 1;
+
+    FIntPoint BoundsMin = FIntPoint::ZeroValue;
+    FIntPoint BoundsMax = FIntPoint::ZeroValue;
+
+    FORCEINLINE int32 GetBinIndex(int32 Y) const
+    {
+        return (Y-BoundsMin.Y) / BinHeight;
+    }
+
+    FORCEINLINE bool IsOnBounds(const FIntPoint& Point) const
+    {
+        return Point.X >= BoundsMin.X && Point.Y >= BoundsMin.Y
+            && Point.X <= BoundsMax.X && Point.Y <= BoundsMax.Y;
+    }
+
+public:
+
+    FGULPreparedPoly() = default;
+
+    explicit FGULPreparedPoly(TArrayView<const FVector2D> Points)
+    {
+        Build(Points);
+    }
+
+    void Build(TArrayView<const FVector2D> Points);
+
+    void Reset();
+
+    FORCEINLINE bool IsValid() const
+    {
+        return BinCount > 0;
+    }
+
+    FORCEINLINE FBox2D GetBounds() const
+    {
+        return IsValid()
+            ? FBox2D(
+                UGULMathLibrary::ScaleToVector2D(BoundsMin),
+                UGULMathLibrary::ScaleToVector2D(BoundsMax)
+                )
+            : FBox2D(ForceInitToZero);
+    }
+
+    FORCEINLINE const FIntPoint& GetScaledBoundsMin() const
+    {
+        return BoundsMin;
+    }
+
+    FORCEINLINE const FIntPoint& GetScaledBoundsMax() const
+    {
+        return BoundsMax;
+    }
+
+    bool IsPointOnPoly(const FIntPoint& ScaledPoint) const;
+
+    FORCEINLINE bool IsPointOnPoly(const FVector2D& Point) const
+    {
+        return IsPointOnPoly(UGULMathLibrary::ScaleToIntPoint(Point));
+    }
+
+    void ClassifyPoints(TArrayView<const FVector2D> Points, TBitArray<>& OutResults) const;
+
+    // Classify points against the union of prepared polys
+    static void ClassifyPoints(
+        TArrayView<const FVector2D> Points,
+        TBitArray<>& OutResults,
+        TArrayView<const FGULPreparedPoly> Polys
+        );
+
+    // Point-edge crossing test used by IsPointOnPoly().
+    // Returns -1 if the point is on the edge boundary,
+    // 1 if the edge toggles crossing parity and 0 otherwise.
+    FORCEINLINE static int32 TestEdgeCrossing(const FIntPoint& pt, const FIntPoint& ip, const FIntPoint& ipNext)
+    {
+        if (ipNext.Y == pt.Y)
+        {
+            if ((ipNext.X == pt.X) || (ip.Y == pt.Y && 
+              ((ipNext.X > pt.X) == (ip.X < pt.X)))) return -1;
+        }
+        if ((ip.Y < pt.Y) != (ipNext.Y < pt.Y))
+        {
+            if (ip.X >= pt.X)
+            {
+                if (ipNext.X > pt.X) return 1;
+                else
+                {
+                    float d = (float)(ip.X - pt.X) * (ipNext.Y - pt.Y) - 
+                      (float)(ipNext.X - pt.X) * (ip.Y - pt.Y);
+                    if (!d) return -1;
+                    if ((d > 0) == (ipNext.Y > ip.Y)) return 1;
+                }
+            }
+            else
+            {
+                if (ipNext.X > pt.X)
+                {
+                    float d = (float)(ip.X - pt.X) * (ipNext.Y - pt.Y) - 
+                      (float)(ipNext.X - pt.X) * (ip.Y - pt.Y);
+                    if (!d) return -1;
+                    if ((d > 0) == (ipNext.Y > ip.Y)) return 1;
+                }
+            }
+        }
+        return 0;
+    }
+};
+
+// Prepared indexed poly group (outer poly with inner poly holes)
+class GEOMETRYUTILITYLIBRARY_API FGULPreparedPolyGroup
+{
+    FGULPreparedPoly Outer;
+    TArray<FGULPreparedPoly> Inners;
+
+public:
+
+    FGULPreparedPolyGroup() = default;
+
+    FGULPreparedPolyGroup(const FGULIndexedPolyGroup& IndexGroup, const TArray<FGULVector2DGroup>& PolyGroups)
+    {
+        Build(IndexGroup, PolyGroups);
+    }
+
+    void Build(const FGULIndexedPolyGroup& IndexGroup, const TArray<FGULVector2DGroup>& PolyGroups);
+
+    void Reset();
+
+    FORCEINLINE bool IsValid() const
+    {
+        return Outer.IsValid();
+    }
+
+    FORCEINLINE FBox2D GetBounds() const
+    {
+        return Outer.GetBounds();
+    }
+
+    bool IsPointOnPoly(const FIntPoint& ScaledPoint) const;
+
+    FORCEINLINE bool IsPointOnPoly(const FVector2D& Point) const
+    {
+        return IsPointOnPoly(UGULMathLibrary::ScaleToIntPoint(Point));
+    }
+
+    void ClassifyPoints(TArrayView<const FVector2D> Points, TBitArray<>& OutResults) const;
+
+    // Classify points against the union of prepared poly groups
+    static void ClassifyPoints(
+        TArrayView<const FVector2D> Points,
+        TBitArray<>& OutResults,
+        TArrayView<const FGULPreparedPolyGroup> PolyGroups
+        );
+};
@@ -95,6 +95,99 @@ void UGULGeometryUtility::AlignBoxToBottom(TArray<FGULOrientedBox>& OutBoxes, TA
     }
 }
 
+void UGULGeometryUtility::SegmentsIntersectBounds(
+    TArray<bool>& OutResults,
+    TArrayView<const FVector2D> InPoints0,
+    TArrayView<const FVector2D> InPoints1,
+    const FBox2D& Bounds
+    )
+{
+    check(InPoints0.Num() == InPoints1.Num());
+
+    const int32 SegmentCount = InPoints0.Num();
+    const int32 BatchCount = SegmentCount / 4;
+
+    OutResults.SetNumUninitialized(SegmentCount);
+
+    const VectorRegister BoundsMinX = VectorSetFloat1(Bounds.Min.X);
+    const VectorRegister BoundsMinY = VectorSetFloat1(Bounds.Min.Y);
+    const VectorRegister BoundsMaxX = VectorSetFloat1(Bounds.Max.X);
+    const VectorRegister BoundsMaxY = VectorSetFloat1(Bounds.Max.Y);
+    const VectorRegister Zero = VectorZero();
+
+    MS_ALIGN(16) float X0[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float Y0[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float X1[4] GCC_ALIGN(16);
+    MS_ALIGN(16) float Y1[4] GCC_ALIGN(16);
+
+    for (int32 BatchIndex=0; BatchIndex<BatchCount; ++BatchIndex)
+    {
+        const int32 SegmentOffset = BatchIndex*4;
+
+        for (int32 i=0; i<4; ++i)
+        {
+            const FVector2D& P0(InPoints0[SegmentOffset+i]);
+            const FVector2D& P1(InPoints1[SegmentOffset+i]);
+            X0[i] = P0.X;
+            Y0[i] = P0.Y;
+            X1[i] = P1.X;
+            Y1[i] = P1.Y;
+        }
+
+        const VectorRegister VX0 = VectorLoadAligned(X0);
+        const VectorRegister VY0 = VectorLoadAligned(Y0);
+        const VectorRegister VX1 = VectorLoadAligned(X1);
+        const VectorRegister VY1 = VectorLoadAligned(Y1);
+
+        // Segment bounds overlap, equals to outcode trivial reject test
+
+        VectorRegister Mask = VectorBitwiseAnd(
+            VectorCompareGE(BoundsMaxX, VectorMin(VX0, VX1)),
+            VectorCompareGE(VectorMax(VX0, VX1), BoundsMinX)
+            );
+
+        Mask = VectorBitwiseAnd(Mask, VectorBitwiseAnd(
+            VectorCompareGE(BoundsMaxY, VectorMin(VY0, VY1)),
+            VectorCompareGE(VectorMax(VY0, VY1), BoundsMinY)
+            ) );
+
+        // Bounds corners segment line side
+
+        const VectorRegister DX = VectorSubtract(VX1, VX0);
+        const VectorRegister DY = VectorSubtract(VY1, VY0);
+
+        const VectorRegister AMin = VectorMultiply(DX, VectorSubtract(BoundsMinY, VY0));
+        const VectorRegister AMax = VectorMultiply(DX, VectorSubtract(BoundsMaxY, VY0));
+        const VectorRegister BMin = VectorMultiply(DY, VectorSubtract(BoundsMinX, VX0));
+        const VectorRegister BMax = VectorMultiply(DY, VectorSubtract(BoundsMaxX, VX0));
+
+        const VectorRegister C00 = VectorSubtract(AMin, BMin);
+        const VectorRegister C10 = VectorSubtract(AMin, BMax);
+        const VectorRegister C01 = VectorSubtract(AMax, BMin);
+        const VectorRegister C11 = VectorSubtract(AMax, BMax);
+
+        const VectorRegister CMin = VectorMin(VectorMin(C00, C10), VectorMin(C01, C11));
+        const VectorRegister CMax = VectorMax(VectorMax(C00, C10), VectorMax(C01, C11));
+
+        Mask = VectorBitwiseAnd(Mask, VectorBitwiseAnd(
+            VectorCompareGE(Zero, CMin),
+            VectorCompareGE(CMax, Zero)
+            ) );
+
+        const int32 MaskBits = VectorMaskBits(Mask);
+
+        for (int32 i=0; i<4; ++i)
+        {
+            OutResults[SegmentOffset+i] = (MaskBits & (1<<i)) != 0;
+        }
+    }
+
+    for (int32 i=BatchCount*4; i<SegmentCount; ++i)
+    {
+        OutResults[i] = SegmentIntersectsBounds(InPoints0[i], InPoints1[i], Bounds);
+    }
+}
+
 struct FGULSegmentDistToSegment2D_Solver
 {
 	FGULSegmentDistToSegment2D_Solver(const FVector2D& InA1, const FVector2D& InB1, const FVector2D& InA2, const FVector2D& InB2):
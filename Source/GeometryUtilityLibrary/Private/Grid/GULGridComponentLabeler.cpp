@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridComponentLabeler.h"
+#include "Grid/GULSparseGrid.h"
+#include "Async/ParallelFor.h"
+
+void FGULGridComponentLabeler::Init(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+{
+    check(InBoundsMin.X <= InBoundsMax.X && InBoundsMin.Y <= InBoundsMax.Y);
+
+    BoundsMin = InBoundsMin;
+    BoundsMax = InBoundsMax;
+    Stride = (BoundsMax.X-BoundsMin.X)+1;
+    RowCount = (BoundsMax.Y-BoundsMin.Y)+1;
+
+    BoundaryStates.Init(false, Stride*RowCount);
+
+    Labels.Reset();
+    Components.Reset();
+    BandComponentAreas.Reset();
+}
+
+void FGULGridComponentLabeler::SetBoundaryPoints(const TArray<FIntPoint>& Points)
+{
+    for (const FIntPoint& Point : Points)
+    {
+        if (IsOnBounds(Point))
+        {
+            BoundaryStates[(Point.X-BoundsMin.X) + (Point.Y-BoundsMin.Y)*Stride] = true;
+        }
+    }
+}
+
+void FGULGridComponentLabeler::SetBoundaryGrid(const FGULSparseGrid& Grid)
+{
+    Grid.ForEach([this](const FIntPoint& Point)
+    {
+        if (IsOnBounds(Point))
+        {
+            BoundaryStates[(Point.X-BoundsMin.X) + (Point.Y-BoundsMin.Y)*Stride] = true;
+        }
+    } );
+}
+
+void FGULGridComponentLabeler::LabelRowBand(TArray<int32>& Parents, int32 Row0, int32 Row1) const
+{
+    for (int32 y=Row0; y<=Row1; ++y)
+    {
+        const int32 RowIndex = y*Stride;
+
+        for (int32 x=0; x<Stride; ++x)
+        {
+            const int32 Index = RowIndex+x;
+
+            Parents[Index] = Index;
+
+            if (BoundaryStates[Index])
+            {
+                continue;
+            }
+
+            // Merge with west and south neighbours,
+            // south neighbours are only merged within the band
+
+            if (x > 0 && ! BoundaryStates[Index-1])
+            {
+                Union(Parents, Index, Index-1);
+            }
+
+            if (y > Row0 && ! BoundaryStates[Index-Stride])
+            {
+                Union(Parents, Index, Index-Stride);
+            }
+        }
+    }
+}
+
+void FGULGridComponentLabeler::Label(int32 InRowBandSize)
+{
+    RowBandSize = FMath::Max(1, InRowBandSize);
+
+    Labels.Reset();
+    Components.Reset();
+    BandComponentAreas.Reset();
+
+    const int32 CellCount = BoundaryStates.Num();
+
+    if (CellCount < 1)
+    {
+        return;
+    }
+
+    const int32 BandCount = GetBandNum();
+
+    TArray<int32> Parents;
+    Parents.SetNumUninitialized(CellCount);
+
+    // First pass, label row bands independently
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Row0 = BandIndex*RowBandSize;
+        const int32 Row1 = FMath::Min(Row0+RowBandSize, RowCount)-1;
+
+        LabelRowBand(Parents, Row0, Row1);
+    } );
+
+    // Merge components across row band seams
+
+    for (int32 BandIndex=1; BandIndex<BandCount; ++BandIndex)
+    {
+        const int32 RowIndex = BandIndex*RowBandSize*Stride;
+
+        for (int32 x=0; x<Stride; ++x)
+        {
+            const int32 Index = RowIndex+x;
+
+            if (! BoundaryStates[Index] && ! BoundaryStates[Index-Stride])
+            {
+                Union(Parents, Index, Index-Stride);
+            }
+        }
+    }
+
+    // Second pass, resolve cell roots. Parents are read-only here.
+
+    TArray<int32> BandRootCounts;
+    BandRootCounts.SetNumZeroed(BandCount);
+
+    Labels.SetNumUninitialized(CellCount);
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Index0 = BandIndex*RowBandSize*Stride;
+        const int32 Index1 = FMath::Min(Index0+RowBandSize*Stride, CellCount);
+
+        int32 RootCount = 0;
+
+        for (int32 Index=Index0; Index<Index1; ++Index)
+        {
+            if (BoundaryStates[Index])
+            {
+                Labels[Index] = INDEX_NONE;
+                continue;
+            }
+
+            const int32 Root = FindRootConst(Parents, Index);
+            Labels[Index] = Root;
+
+            if (Root == Index)
+            {
+                ++RootCount;
+            }
+        }
+
+        BandRootCounts[BandIndex] = RootCount;
+    } );
+
+    // Assign component indices to roots in row-major order,
+    // root parents are reused to store root component index
+
+    int32 ComponentCount = 0;
+
+    for (int32& RootCount : BandRootCounts)
+    {
+        const int32 BandComponentOffset = ComponentCount;
+        ComponentCount += RootCount;
+        RootCount = BandComponentOffset;
+    }
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Index0 = BandIndex*RowBandSize*Stride;
+        const int32 Index1 = FMath::Min(Index0+RowBandSize*Stride, CellCount);
+
+        int32 ComponentIndex = BandRootCounts[BandIndex];
+
+        for (int32 Index=Index0; Index<Index1; ++Index)
+        {
+            if (Labels[Index] == Index)
+            {
+                Parents[Index] = ComponentIndex++;
+            }
+        }
+    } );
+
+    // Assign cell component labels and gather band component summaries
+
+    TArray< TMap<int32, FGULGridComponent> > BandComponents;
+    BandComponents.SetNum(BandCount);
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Row0 = BandIndex*RowBandSize;
+        const int32 Row1 = FMath::Min(Row0+RowBandSize, RowCount)-1;
+
+        TMap<int32, FGULGridComponent>& LocalComponents(BandComponents[BandIndex]);
+        FGULGridComponent* Component = nullptr;
+        int32 LastComponentIndex = INDEX_NONE;
+
+        for (int32 y=Row0; y<=Row1; ++y)
+        {
+            const int32 RowIndex = y*Stride;
+
+            for (int32 x=0; x<Stride; ++x)
+            {
+                const int32 Index = RowIndex+x;
+
+                if (Labels[Index] == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const int32 ComponentIndex = Parents[Labels[Index]];
+                Labels[Index] = ComponentIndex;
+
+                // Cells of the same component mostly come in runs
+                if (ComponentIndex != LastComponentIndex)
+                {
+                    Component = &LocalComponents.FindOrAdd(ComponentIndex);
+                    LastComponentIndex = ComponentIndex;
+                }
+
+                Component->Add(BoundsMin.X+x, BoundsMin.Y+y);
+            }
+        }
+    } );
+
+    // Merge band component summaries
+
+    Components.SetNum(ComponentCount);
+    BandComponentAreas.SetNum(BandCount);
+
+    for (int32 BandIndex=0; BandIndex<BandCount; ++BandIndex)
+    {
+        for (const auto& ComponentPair : BandComponents[BandIndex])
+        {
+            Components[ComponentPair.Key].Add(ComponentPair.Value);
+            BandComponentAreas[BandIndex].Emplace(ComponentPair.Key, ComponentPair.Value.Area);
+        }
+    }
+}
+
+void FGULGridComponentLabeler::GenerateComponentPoints(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    const TArray<int32>& ComponentGroupIndices
+    ) const
+{
+    check(ComponentGroupIndices.Num() == Components.Num());
+
+    const int32 BandCount = BandComponentAreas.Num();
+    const int32 ComponentCount = Components.Num();
+
+    // Allocate output group points
+
+    for (int32 ComponentIndex=0; ComponentIndex<ComponentCount; ++ComponentIndex)
+    {
+        const int32 GroupIndex = ComponentGroupIndices[ComponentIndex];
+
+        if (GroupIndex != INDEX_NONE)
+        {
+            check(OutPointGroups.IsValidIndex(GroupIndex));
+            OutPointGroups[GroupIndex].Points.SetNumUninitialized(Components[ComponentIndex].Area);
+        }
+    }
+
+    // Generate component write offsets for each row band
+
+    TArray< TMap<int32, int32> > BandWriteOffsets;
+    BandWriteOffsets.SetNum(BandCount);
+
+    TArray<int32> ComponentOffsets;
+    ComponentOffsets.SetNumZeroed(ComponentCount);
+
+    for (int32 BandIndex=0; BandIndex<BandCount; ++BandIndex)
+    {
+        for (const auto& AreaPair : BandComponentAreas[BandIndex])
+        {
+            int32& ComponentOffset(ComponentOffsets[AreaPair.Key]);
+            BandWriteOffsets[BandIndex].Emplace(AreaPair.Key, ComponentOffset);
+            ComponentOffset += AreaPair.Value;
+        }
+    }
+
+    // Write component points, each band writes to its own point range
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Row0 = BandIndex*RowBandSize;
+        const int32 Row1 = FMath::Min(Row0+RowBandSize, RowCount)-1;
+
+        TMap<int32, int32>& WriteOffsets(BandWriteOffsets[BandIndex]);
+        int32* WriteOffset = nullptr;
+        int32 LastComponentIndex = INDEX_NONE;
+
+        for (int32 y=Row0; y<=Row1; ++y)
+        {
+            const int32 RowIndex = y*Stride;
+
+            for (int32 x=0; x<Stride; ++x)
+            {
+                const int32 ComponentIndex = Labels[RowIndex+x];
+
+                if (ComponentIndex == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const int32 GroupIndex = ComponentGroupIndices[ComponentIndex];
+
+                if (GroupIndex == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                if (ComponentIndex != LastComponentIndex)
+                {
+                    WriteOffset = &WriteOffsets.FindChecked(ComponentIndex);
+                    LastComponentIndex = ComponentIndex;
+                }
+
+                OutPointGroups[GroupIndex].Points[(*WriteOffset)++] = FIntPoint(BoundsMin.X+x, BoundsMin.Y+y);
+            }
+        }
+    } );
+}
@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridDistanceTransform.h"
+#include "Async/ParallelFor.h"
+
+#define GUL_GRID_DISTANCE_BATCH_SIZE 64
+#define GUL_GRID_DISTANCE_INF MAX_int32
+
+void FGULGridDistanceTransform::Init(const FIntPoint& InBoundsMin, const FIntPoint& InBoundsMax)
+{
+    check(InBoundsMin.X <= InBoundsMax.X && InBoundsMin.Y <= InBoundsMax.Y);
+
+    BoundsMin = InBoundsMin;
+    BoundsMax = InBoundsMax;
+    Stride = (BoundsMax.X-BoundsMin.X)+1;
+    RowCount = (BoundsMax.Y-BoundsMin.Y)+1;
+
+    Distances.Reset();
+}
+
+bool FGULGridDistanceTransform::Generate(const TArray<FIntPoint>& SeedPoints, EGULGridDistanceMetric Metric)
+{
+    const int32 CellCount = GetCellCount();
+
+    Distances.Reset();
+
+    if (CellCount < 1)
+    {
+        return false;
+    }
+
+    TBitArray<> SeedStates(false, CellCount);
+    bool bHasSeed = false;
+
+    for (const FIntPoint& SeedPoint : SeedPoints)
+    {
+        if (IsOnBounds(SeedPoint))
+        {
+            SeedStates[GetIndex(SeedPoint)] = true;
+            bHasSeed = true;
+        }
+    }
+
+    if (! bHasSeed)
+    {
+        return false;
+    }
+
+    Distances.SetNumUninitialized(CellCount);
+
+    switch (Metric)
+    {
+        case EGULGridDistanceMetric::Chamfer:
+            GenerateChamfer(SeedStates);
+            break;
+
+        case EGULGridDistanceMetric::Manhattan:
+            GenerateManhattan(SeedStates);
+            break;
+
+        case EGULGridDistanceMetric::Euclidean:
+        default:
+            GenerateEuclidean(SeedStates);
+            break;
+    }
+
+    return true;
+}
+
+void FGULGridDistanceTransform::GenerateColumnDistances(TArray<int32>& OutColumnDistances, const TBitArray<>& SeedStates) const
+{
+    const int32 CellCount = GetCellCount();
+    const int32 BatchSize = GUL_GRID_DISTANCE_BATCH_SIZE;
+    const int32 BatchCount = (Stride+BatchSize-1) / BatchSize;
+
+    OutColumnDistances.SetNumUninitialized(CellCount);
+
+    // Column batches are swept row by row to keep row memory access linear
+
+    ParallelFor(BatchCount, [&](int32 BatchIndex)
+    {
+        const int32 x0 = BatchIndex*BatchSize;
+        const int32 x1 = FMath::Min(x0+BatchSize, Stride);
+
+        // Downward sweep
+
+        for (int32 y=0; y<RowCount; ++y)
+        {
+            const int32 RowIndex = y*Stride;
+
+            for (int32 x=x0; x<x1; ++x)
+            {
+                const int32 Index = RowIndex+x;
+
+                if (SeedStates[Index])
+                {
+                    OutColumnDistances[Index] = 0;
+                }
+                else
+                {
+                    const int32 PrevDistance = (y > 0) ? OutColumnDistances[Index-Stride] : GUL_GRID_DISTANCE_INF;
+                    OutColumnDistances[Index] = (PrevDistance < GUL_GRID_DISTANCE_INF) ? PrevDistance+1 : GUL_GRID_DISTANCE_INF;
+                }
+            }
+        }
+
+        // Upward sweep
+
+        for (int32 y=RowCount-2; y>=0; --y)
+        {
+            const int32 RowIndex = y*Stride;
+
+            for (int32 x=x0; x<x1; ++x)
+            {
+                const int32 Index = RowIndex+x;
+                const int32 NextDistance = OutColumnDistances[Index+Stride];
+
+                if (NextDistance < GUL_GRID_DISTANCE_INF && NextDistance+1 < OutColumnDistances[Index])
+                {
+                    OutColumnDistances[Index] = NextDistance+1;
+                }
+            }
+        }
+    } );
+}
+
+void FGULGridDistanceTransform::GenerateEuclidean(const TBitArray<>& SeedStates)
+{
+    TArray<int32> ColumnDistances;
+    GenerateColumnDistances(ColumnDistances, SeedStates);
+
+    const int32 BatchSize = GUL_GRID_DISTANCE_BATCH_SIZE;
+    const int32 BatchCount = (RowCount+BatchSize-1) / BatchSize;
+
+    // Row pass, lower envelope of parabolas f(q) + (x-q)^2 where f(q) is
+    // the squared column distance. Envelope math is kept in double so that
+    // squared distances of large grids stay exact.
+
+    ParallelFor(BatchCount, [&](int32 BatchIndex)
+    {
+        const int32 y0 = BatchIndex*BatchSize;
+        const int32 y1 = FMath::Min(y0+BatchSize, RowCount);
+
+        TArray<int32> Vertices;
+        TArray<double> Boundaries;
+
+        Vertices.SetNumUninitialized(Stride);
+        Boundaries.SetNumUninitialized(Stride+1);
+
+        for (int32 y=y0; y<y1; ++y)
+        {
+            const int32 RowIndex = y*Stride;
+            const int32* RowDistances = ColumnDistances.GetData()+RowIndex;
+
+            auto GetParabolaValue = [RowDistances](int32 q)
+            {
+                const double ColumnDistance = RowDistances[q];
+                return ColumnDistance*ColumnDistance + static_cast<double>(q)*q;
+            };
+
+            // Generate lower envelope, skipping columns without seeds
+
+            int32 k = -1;
+
+            for (int32 q=0; q<Stride; ++q)
+            {
+                if (RowDistances[q] == GUL_GRID_DISTANCE_INF)
+                {
+                    continue;
+                }
+
+                if (k < 0)
+                {
+                    k = 0;
+                    Vertices[0] = q;
+                    Boundaries[0] = -BIG_NUMBER;
+                    Boundaries[1] = BIG_NUMBER;
+                    continue;
+                }
+
+                const double ValueQ = GetParabolaValue(q);
+                double s;
+
+                while (true)
+                {
+                    const int32 v = Vertices[k];
+                    s = (ValueQ - GetParabolaValue(v)) / (2.0*(q-v));
+
+                    if (s <= Boundaries[k])
+                    {
+                        --k;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+
+                ++k;
+                Vertices[k] = q;
+                Boundaries[k] = s;
+                Boundaries[k+1] = BIG_NUMBER;
+            }
+
+            // No seed on any column, only possible for empty seed set
+
+            if (k < 0)
+            {
+                for (int32 x=0; x<Stride; ++x)
+                {
+                    Distances[RowIndex+x] = MAX_FLT;
+                }
+                continue;
+            }
+
+            // Evaluate lower envelope
+
+            k = 0;
+
+            for (int32 x=0; x<Stride; ++x)
+            {
+                while (Boundaries[k+1] < x)
+                {
+                    ++k;
+                }
+
+                const int32 v = Vertices[k];
+                const double dx = x-v;
+                const double dy = RowDistances[v];
+
+                Distances[RowIndex+x] = static_cast<float>(FMath::Sqrt(dx*dx + dy*dy));
+            }
+        }
+    } );
+}
+
+void FGULGridDistanceTransform::GenerateManhattan(const TBitArray<>& SeedStates)
+{
+    TArray<int32> ColumnDistances;
+    GenerateColumnDistances(ColumnDistances, SeedStates);
+
+    const int32 BatchSize = GUL_GRID_DISTANCE_BATCH_SIZE;
+    const int32 BatchCount = (RowCount+BatchSize-1) / BatchSize;
+
+    // Row pass, forward and backward min sweeps of column distances
+
+    ParallelFor(BatchCount, [&](int32 BatchIndex)
+    {
+        const int32 y0 = BatchIndex*BatchSize;
+        const int32 y1 = FMath::Min(y0+BatchSize, RowCount);
+
+        for (int32 y=y0; y<y1; ++y)
+        {
+            int32* RowDistances = ColumnDistances.GetData()+y*Stride;
+
+            for (int32 x=1; x<Stride; ++x)
+            {
+                const int32 PrevDistance = RowDistances[x-1];
+
+                if (PrevDistance < GUL_GRID_DISTANCE_INF && PrevDistance+1 < RowDistances[x])
+                {
+                    RowDistances[x] = PrevDistance+1;
+                }
+            }
+
+            for (int32 x=Stride-2; x>=0; --x)
+            {
+                const int32 NextDistance = RowDistances[x+1];
+
+                if (NextDistance < GUL_GRID_DISTANCE_INF && NextDistance+1 < RowDistances[x])
+                {
+                    RowDistances[x] = NextDistance+1;
+                }
+            }
+
+            float* OutDistances = Distances.GetData()+y*Stride;
+
+            for (int32 x=0; x<Stride; ++x)
+            {
+                OutDistances[x] = (RowDistances[x] < GUL_GRID_DISTANCE_INF)
+                    ? static_cast<float>(RowDistances[x])
+                    : MAX_FLT;
+            }
+        }
+    } );
+}
+
+void FGULGridDistanceTransform::GenerateChamfer(const TBitArray<>& SeedStates)
+{
+    const int32 CellCount = GetCellCount();
+    const float AxisStep = 1.f;
+    const float DiagonalStep = 1.41421356f;
+
+    for (int32 i=0; i<CellCount; ++i)
+    {
+        Distances[i] = SeedStates[i] ? 0.f : MAX_FLT;
+    }
+
+    auto RelaxCell = [this](int32 Index, int32 x, int32 y, int32 dx, int32 dy, float Step)
+    {
+        const int32 nx = x+dx;
+        const int32 ny = y+dy;
+
+        if (nx < 0 || ny < 0 || nx >= Stride || ny >= RowCount)
+        {
+            return;
+        }
+
+        const float NeighbourDistance = Distances[nx + ny*Stride];
+
+        if (NeighbourDistance < MAX_FLT && NeighbourDistance+Step < Distances[Index])
+        {
+            Distances[Index] = NeighbourDistance+Step;
+        }
+    };
+
+    // Forward raster pass
+
+    for (int32 y=0; y<RowCount; ++y)
+    for (int32 x=0; x<Stride; ++x)
+    {
+        const int32 Index = x + y*Stride;
+        RelaxCell(Index, x, y, -1,  0, AxisStep);
+        RelaxCell(Index, x, y, -1, -1, DiagonalStep);
+        RelaxCell(Index, x, y,  0, -1, AxisStep);
+        RelaxCell(Index, x, y,  1, -1, DiagonalStep);
+    }
+
+    // Backward raster pass
+
+    for (int32 y=RowCount-1; y>=0; --y)
+    for (int32 x=Stride-1; x>=0; --x)
+    {
+        const int32 Index = x + y*Stride;
+        RelaxCell(Index, x, y,  1,  0, AxisStep);
+        RelaxCell(Index, x, y,  1,  1, DiagonalStep);
+        RelaxCell(Index, x, y,  0,  1, AxisStep);
+        RelaxCell(Index, x, y, -1,  1, DiagonalStep);
+    }
+}
+
+void FGULGridDistanceTransform::GetDistancesUInt16(TArray<uint16>& OutDistances, float DistanceScale) const
+{
+    const int32 CellCount = Distances.Num();
+
+    OutDistances.SetNumUninitialized(CellCount);
+
+    for (int32 i=0; i<CellCount; ++i)
+    {
+        const float ScaledDistance = Distances[i]*DistanceScale;
+
+        OutDistances[i] = (ScaledDistance < static_cast<float>(MAX_uint16))
+            ? static_cast<uint16>(FMath::RoundToInt(ScaledDistance))
+            : MAX_uint16;
+    }
+}
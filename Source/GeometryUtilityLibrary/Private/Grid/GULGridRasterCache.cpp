@@ -0,0 +1,646 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridRasterCache.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+#include "GeometryUtilityLibrary.h"
+#include "GULSortUtility.h"
+#include "Grid/GULGridUtility.h"
+
+FGULGridRasterCache::FGULGridRasterCache(
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    int32 InTileDimensionX,
+    int32 InTileDimensionY,
+    EGULGridFillMode InFillMode,
+    bool bInClosedPolygons,
+    int32 InGridSizePerSegment
+    )
+    : GridSizeX(FMath::Max(1, InGridSizeX))
+    , GridSizeY(FMath::Max(1, InGridSizeY))
+    , TileDimensionX(FMath::Max(1, InTileDimensionX))
+    , TileDimensionY(FMath::Max(1, InTileDimensionY))
+    , FillMode(InFillMode)
+    , bClosedPolygons(bInClosedPolygons)
+    , GridSizePerSegment(InGridSizePerSegment)
+{
+}
+
+void FGULGridRasterCache::Reset()
+{
+    Rings.Reset();
+    Tiles.Reset();
+    DirtyTileIds.Reset();
+    FillBoundsMin = FIntPoint::ZeroValue;
+    FillBoundsMax = FIntPoint(-1, -1);
+    Components.Reset();
+    TileRangeMin = FIntPoint::ZeroValue;
+    TileRangeMax = FIntPoint(-1, -1);
+    InteriorTileComponents.Reset();
+}
+
+void FGULGridRasterCache::GetRingKey(uint32& OutHash, FBox2D& OutBounds, const TArray<FVector2D>& Points)
+{
+    OutHash = FCrc::MemCrc32(Points.GetData(), Points.Num()*sizeof(FVector2D));
+    OutBounds = FBox2D(ForceInitToZero);
+
+    for (const FVector2D& Point : Points)
+    {
+        OutBounds += Point;
+    }
+}
+
+void FGULGridRasterCache::AddDirtyTiles(TSet<FIntPoint>& DirtyTileSet, const FRing& Ring) const
+{
+    if (! HasValidBounds(Ring.CellMin, Ring.CellMax))
+    {
+        return;
+    }
+
+    const FIntPoint TileMin(GetTileId(Ring.CellMin));
+    const FIntPoint TileMax(GetTileId(Ring.CellMax));
+
+    for (int32 y=TileMin.Y; y<=TileMax.Y; ++y)
+    for (int32 x=TileMin.X; x<=TileMax.X; ++x)
+    {
+        DirtyTileSet.Emplace(FIntPoint(x, y));
+    }
+}
+
+void FGULGridRasterCache::GetTileFillBounds(const FIntPoint& TileId, FIntPoint& OutFillMin, FIntPoint& OutFillMax) const
+{
+    const FIntPoint TileMin(TileId.X*TileDimensionX, TileId.Y*TileDimensionY);
+    const FIntPoint TileMax(TileMin.X+TileDimensionX-1, TileMin.Y+TileDimensionY-1);
+
+    OutFillMin.X = FMath::Max(TileMin.X, FillBoundsMin.X);
+    OutFillMin.Y = FMath::Max(TileMin.Y, FillBoundsMin.Y);
+    OutFillMax.X = FMath::Min(TileMax.X, FillBoundsMax.X);
+    OutFillMax.Y = FMath::Min(TileMax.Y, FillBoundsMax.Y);
+}
+
+void FGULGridRasterCache::BuildRing(FRing& Ring, const TArray<FVector2D>& Points) const
+{
+    GetRingKey(Ring.Hash, Ring.Bounds, Points);
+    Ring.PointCount = Points.Num();
+
+    if (Points.Num() < 2)
+    {
+        return;
+    }
+
+    const FVector2D GridSize(GridSizeX, GridSizeY);
+    const float SparseLength = (GridSize*FMath::Max(1,GridSizePerSegment)).Size();
+
+    TArray<FIntPoint> GridIds;
+
+    UGULGridUtility::GenerateGridsFromPolyPoints(
+        GridIds,
+        Points,
+        GridSizeX,
+        GridSizeY,
+        bClosedPolygons,
+        SparseLength
+        );
+
+    UGULGridUtility::SortUniqueGridIds(GridIds);
+
+    if (GridIds.Num() > 0)
+    {
+        Ring.CellMin = FIntPoint(MAX_int32, MAX_int32);
+        Ring.CellMax = FIntPoint(MIN_int32, MIN_int32);
+
+        for (const FIntPoint& GridId : GridIds)
+        {
+            Ring.CellMin.X = FMath::Min(Ring.CellMin.X, GridId.X);
+            Ring.CellMin.Y = FMath::Min(Ring.CellMin.Y, GridId.Y);
+            Ring.CellMax.X = FMath::Max(Ring.CellMax.X, GridId.X);
+            Ring.CellMax.Y = FMath::Max(Ring.CellMax.Y, GridId.Y);
+        }
+    }
+
+    // Group unique grid ids by tiles
+
+    UGULGridUtility::GroupGridRangesByDimension(
+        Ring.TileIds,
+        Ring.TileOffsets,
+        Ring.Cells,
+        GridIds,
+        TileDimensionX,
+        TileDimensionY,
+        EGULGridOrder::RowMajor
+        );
+}
+
+void FGULGridRasterCache::BuildTile(const FIntPoint& TileId, FTile& Tile) const
+{
+    // Gather unique boundary cells of all rings touching the tile
+
+    TArray<uint64> GridKeys;
+
+    for (const FRingTile& RingTile : Tile.RingTiles)
+    {
+        const FRing& Ring(Rings[RingTile.RingIndex]);
+        const int32 CellStart = Ring.TileOffsets[RingTile.TileIndex];
+        const int32 CellEnd = Ring.TileOffsets[RingTile.TileIndex+1];
+
+        for (int32 i=CellStart; i<CellEnd; ++i)
+        {
+            GridKeys.Emplace(UGULMathLibrary::PackGridKey(Ring.Cells[i]));
+        }
+    }
+
+    FGULSortUtility::RadixSort(GridKeys);
+
+    const int32 GridCount = GridKeys.Num();
+
+    Tile.BoundaryCells.Reset(GridCount);
+
+    for (int32 i=0; i<GridCount; ++i)
+    {
+        if (i == 0 || GridKeys[i] != GridKeys[i-1])
+        {
+            Tile.BoundaryCells.Emplace(UGULMathLibrary::UnpackGridKey(GridKeys[i]));
+        }
+    }
+
+    // Generate isolated point groups within tile fill bounds. Boundary cells
+    // are always within the fill bounds, every group is adjacent to at least
+    // one tile boundary cell.
+
+    GetTileFillBounds(TileId, Tile.FillMin, Tile.FillMax);
+
+    Tile.PointGroups.Reset();
+    Tile.ComponentIds.Reset();
+
+    UGULGridUtility::GenerateIsolatedPointGroupsWithinBounds(
+        Tile.PointGroups,
+        Tile.BoundaryCells,
+        Tile.FillMin,
+        Tile.FillMax,
+        FillMode
+        );
+
+    // Label fill bounds cells by point group index and extract edge labels
+
+    const int32 FillSizeX = Tile.FillMax.X-Tile.FillMin.X+1;
+    const int32 FillSizeY = Tile.FillMax.Y-Tile.FillMin.Y+1;
+    const int32 GroupCount = Tile.PointGroups.Num();
+
+    TArray<int32> Labels;
+    Labels.Init(INDEX_NONE, FillSizeX*FillSizeY);
+
+    Tile.PointGroupComponents.Reset(GroupCount);
+    Tile.PointGroupComponents.SetNum(GroupCount);
+
+    for (int32 GroupIt=0; GroupIt<GroupCount; ++GroupIt)
+    {
+        FGULGridComponent& Component(Tile.PointGroupComponents[GroupIt]);
+
+        for (const FIntPoint& Point : Tile.PointGroups[GroupIt].Points)
+        {
+            Labels[(Point.X-Tile.FillMin.X) + (Point.Y-Tile.FillMin.Y)*FillSizeX] = GroupIt;
+            Component.Add(Point.X, Point.Y);
+        }
+    }
+
+    Tile.EdgeLabels.SetNumUninitialized(2*FillSizeX + 2*FillSizeY);
+
+    int32* BottomLabels = Tile.EdgeLabels.GetData();
+    int32* TopLabels = BottomLabels + FillSizeX;
+    int32* LeftLabels = TopLabels + FillSizeX;
+    int32* RightLabels = LeftLabels + FillSizeY;
+
+    for (int32 x=0; x<FillSizeX; ++x)
+    {
+        BottomLabels[x] = Labels[x];
+        TopLabels[x] = Labels[x + (FillSizeY-1)*FillSizeX];
+    }
+
+    for (int32 y=0; y<FillSizeY; ++y)
+    {
+        LeftLabels[y] = Labels[y*FillSizeX];
+        RightLabels[y] = Labels[(FillSizeX-1) + y*FillSizeX];
+    }
+}
+
+void FGULGridRasterCache::ResolveComponents()
+{
+    Components.Reset();
+    InteriorTileComponents.Reset();
+
+    if (! HasValidBounds(FillBoundsMin, FillBoundsMax))
+    {
+        TileRangeMin = FIntPoint::ZeroValue;
+        TileRangeMax = FIntPoint(-1, -1);
+        return;
+    }
+
+    TileRangeMin = GetTileId(FillBoundsMin);
+    TileRangeMax = GetTileId(FillBoundsMax);
+
+    const int32 TileCountX = TileRangeMax.X-TileRangeMin.X+1;
+    const int32 TileCountY = TileRangeMax.Y-TileRangeMin.Y+1;
+    const int32 TileCount = TileCountX*TileCountY;
+
+    // Assign fragment offsets, interior tiles hold a single fragment
+
+    TArray<FTile*> RangeTiles;
+    TArray<int32> FragmentOffsets;
+    RangeTiles.SetNumUninitialized(TileCount);
+    FragmentOffsets.SetNumUninitialized(TileCount+1);
+
+    int32 FragmentCount = 0;
+
+    for (int32 ty=0; ty<TileCountY; ++ty)
+    for (int32 tx=0; tx<TileCountX; ++tx)
+    {
+        const int32 TileIndex = tx + ty*TileCountX;
+        FTile* Tile = Tiles.Find(FIntPoint(TileRangeMin.X+tx, TileRangeMin.Y+ty));
+
+        RangeTiles[TileIndex] = Tile;
+        FragmentOffsets[TileIndex] = FragmentCount;
+        FragmentCount += Tile ? Tile->PointGroups.Num() : 1;
+    }
+
+    FragmentOffsets[TileCount] = FragmentCount;
+
+    TArray<int32> Parents;
+    Parents.SetNumUninitialized(FragmentCount);
+
+    for (int32 i=0; i<FragmentCount; ++i)
+    {
+        Parents[i] = i;
+    }
+
+    // Merge fragments across tile edges. Edge labels are offsets into the
+    // tile edge label array, see FTile::EdgeLabels.
+
+    auto MergeEdge = [&](int32 TileIndexA, int32 EdgeOffsetA, int32 TileIndexB, int32 EdgeOffsetB, int32 EdgeSize)
+    {
+        const FTile* TileA = RangeTiles[TileIndexA];
+        const FTile* TileB = RangeTiles[TileIndexB];
+        const int32 OffsetA = FragmentOffsets[TileIndexA];
+        const int32 OffsetB = FragmentOffsets[TileIndexB];
+
+        if (! TileA && ! TileB)
+        {
+            Union(Parents, OffsetA, OffsetB);
+            return;
+        }
+
+        for (int32 i=0; i<EdgeSize; ++i)
+        {
+            const int32 LabelA = TileA ? TileA->EdgeLabels[EdgeOffsetA+i] : 0;
+            const int32 LabelB = TileB ? TileB->EdgeLabels[EdgeOffsetB+i] : 0;
+
+            if (LabelA != INDEX_NONE && LabelB != INDEX_NONE)
+            {
+                Union(Parents, OffsetA+LabelA, OffsetB+LabelB);
+            }
+        }
+    };
+
+    for (int32 ty=0; ty<TileCountY; ++ty)
+    for (int32 tx=0; tx<TileCountX; ++tx)
+    {
+        const int32 TileIndex = tx + ty*TileCountX;
+
+        FIntPoint FillMin;
+        FIntPoint FillMax;
+        GetTileFillBounds(FIntPoint(TileRangeMin.X+tx, TileRangeMin.Y+ty), FillMin, FillMax);
+
+        const int32 FillSizeX = FillMax.X-FillMin.X+1;
+        const int32 FillSizeY = FillMax.Y-FillMin.Y+1;
+
+        // Right column against right tile left column
+
+        if (tx+1 < TileCountX)
+        {
+            const int32 RightSizeX = FMath::Min(FillBoundsMax.X-FillMax.X, TileDimensionX);
+
+            MergeEdge(
+                TileIndex,
+                2*FillSizeX + FillSizeY,
+                TileIndex+1,
+                2*RightSizeX,
+                FillSizeY
+                );
+        }
+
+        // Top row against top tile bottom row
+
+        if (ty+1 < TileCountY)
+        {
+            MergeEdge(
+                TileIndex,
+                FillSizeX,
+                TileIndex+TileCountX,
+                0,
+                FillSizeX
+                );
+        }
+    }
+
+    // Assign component indices in fragment order
+
+    TArray<int32> FragmentComponents;
+    FragmentComponents.Init(INDEX_NONE, FragmentCount);
+    InteriorTileComponents.Init(INDEX_NONE, TileCount);
+
+    for (int32 ty=0; ty<TileCountY; ++ty)
+    for (int32 tx=0; tx<TileCountX; ++tx)
+    {
+        const int32 TileIndex = tx + ty*TileCountX;
+        const int32 FragmentStart = FragmentOffsets[TileIndex];
+        const int32 FragmentEnd = FragmentOffsets[TileIndex+1];
+
+        FTile* Tile = RangeTiles[TileIndex];
+
+        if (Tile)
+        {
+            Tile->ComponentIds.SetNumUninitialized(FragmentEnd-FragmentStart);
+        }
+
+        for (int32 i=FragmentStart; i<FragmentEnd; ++i)
+        {
+            const int32 Root = FindRoot(Parents, i);
+
+            if (FragmentComponents[Root] == INDEX_NONE)
+            {
+                FragmentComponents[Root] = Components.AddDefaulted();
+            }
+
+            const int32 ComponentId = FragmentComponents[Root];
+            FGULGridComponent& Component(Components[ComponentId]);
+
+            if (Tile)
+            {
+                Tile->ComponentIds[i-FragmentStart] = ComponentId;
+                Component.Add(Tile->PointGroupComponents[i-FragmentStart]);
+            }
+            else
+            {
+                FIntPoint FillMin;
+                FIntPoint FillMax;
+                GetTileFillBounds(FIntPoint(TileRangeMin.X+tx, TileRangeMin.Y+ty), FillMin, FillMax);
+
+                FGULGridComponent InteriorComponent;
+                InteriorComponent.Area = (FillMax.X-FillMin.X+1) * (FillMax.Y-FillMin.Y+1);
+                InteriorComponent.BoundsMin = FillMin;
+                InteriorComponent.BoundsMax = FillMax;
+
+                InteriorTileComponents[TileIndex] = ComponentId;
+                Component.Add(InteriorComponent);
+            }
+        }
+    }
+}
+
+int32 FGULGridRasterCache::Update(const TArray<FGULVector2DGroup>& InPolys)
+{
+    DirtyTileIds.Reset();
+
+    const int32 PolyCount = InPolys.Num();
+    const int32 CachedRingCount = Rings.Num();
+
+    // Find changed rings by point hash and bounds, rings beyond the input
+    // poly count are removed
+
+    TArray<uint32> PolyHashes;
+    TArray<FBox2D> PolyBounds;
+    PolyHashes.SetNumUninitialized(PolyCount);
+    PolyBounds.SetNumUninitialized(PolyCount);
+
+    ParallelFor(PolyCount, [&](int32 PolyIt)
+    {
+        GetRingKey(PolyHashes[PolyIt], PolyBounds[PolyIt], InPolys[PolyIt].Points);
+    } );
+
+    TArray<int32> ChangedRings;
+
+    for (int32 RingIt=0; RingIt<FMath::Max(PolyCount, CachedRingCount); ++RingIt)
+    {
+        if (RingIt >= PolyCount || RingIt >= CachedRingCount)
+        {
+            ChangedRings.Emplace(RingIt);
+            continue;
+        }
+
+        const FRing& Ring(Rings[RingIt]);
+
+        if (Ring.Hash != PolyHashes[RingIt] ||
+            Ring.PointCount != InPolys[RingIt].Points.Num() ||
+            Ring.Bounds != PolyBounds[RingIt])
+        {
+            ChangedRings.Emplace(RingIt);
+        }
+    }
+
+    const int32 ChangedCount = ChangedRings.Num();
+
+    if (ChangedCount < 1)
+    {
+        return 0;
+    }
+
+    // Rasterize changed rings
+
+    TArray<FRing> ChangedRingData;
+    ChangedRingData.SetNum(ChangedCount);
+
+    ParallelFor(ChangedCount, [&](int32 i)
+    {
+        const int32 RingIndex = ChangedRings[i];
+
+        if (RingIndex < PolyCount)
+        {
+            BuildRing(ChangedRingData[i], InPolys[RingIndex].Points);
+        }
+    } );
+
+    // Replace changed rings, tiles touched by either old or new ring bounds
+    // are marked as dirty
+
+    TSet<FIntPoint> DirtyTileSet;
+
+    if (CachedRingCount < PolyCount)
+    {
+        Rings.SetNum(PolyCount);
+    }
+
+    for (int32 i=0; i<ChangedCount; ++i)
+    {
+        const int32 RingIndex = ChangedRings[i];
+        FRing& Ring(Rings[RingIndex]);
+
+        AddDirtyTiles(DirtyTileSet, Ring);
+
+        for (const FIntPoint& TileId : Ring.TileIds)
+        {
+            if (FTile* Tile = Tiles.Find(TileId))
+            {
+                Tile->RingTiles.RemoveAllSwap([RingIndex](const FRingTile& RingTile)
+                {
+                    return RingTile.RingIndex == RingIndex;
+                } );
+            }
+        }
+
+        Ring = MoveTemp(ChangedRingData[i]);
+
+        AddDirtyTiles(DirtyTileSet, Ring);
+
+        for (int32 TileIt=0; TileIt<Ring.TileIds.Num(); ++TileIt)
+        {
+            Tiles.FindOrAdd(Ring.TileIds[TileIt]).RingTiles.Emplace(RingIndex, TileIt);
+        }
+    }
+
+    Rings.SetNum(PolyCount);
+
+    // Update fill bounds, tiles with changed tile fill bounds are dirty
+
+    FillBoundsMin = FIntPoint(MAX_int32, MAX_int32);
+    FillBoundsMax = FIntPoint(MIN_int32, MIN_int32);
+
+    for (const FRing& Ring : Rings)
+    {
+        if (HasValidBounds(Ring.CellMin, Ring.CellMax))
+        {
+            FillBoundsMin.X = FMath::Min(FillBoundsMin.X, Ring.CellMin.X);
+            FillBoundsMin.Y = FMath::Min(FillBoundsMin.Y, Ring.CellMin.Y);
+            FillBoundsMax.X = FMath::Max(FillBoundsMax.X, Ring.CellMax.X);
+            FillBoundsMax.Y = FMath::Max(FillBoundsMax.Y, Ring.CellMax.Y);
+        }
+    }
+
+    if (! HasValidBounds(FillBoundsMin, FillBoundsMax))
+    {
+        FillBoundsMin = FIntPoint::ZeroValue;
+        FillBoundsMax = FIntPoint(-1, -1);
+    }
+
+    for (const auto& TilePair : Tiles)
+    {
+        FIntPoint FillMin;
+        FIntPoint FillMax;
+        GetTileFillBounds(TilePair.Key, FillMin, FillMax);
+
+        if (FillMin != TilePair.Value.FillMin || FillMax != TilePair.Value.FillMax)
+        {
+            DirtyTileSet.Emplace(TilePair.Key);
+        }
+    }
+
+    // Remove tiles left without rings and rebuild remaining dirty tiles
+
+    DirtyTileIds = DirtyTileSet.Array();
+
+    for (const FIntPoint& TileId : DirtyTileIds)
+    {
+        const FTile* Tile = Tiles.Find(TileId);
+
+        if (Tile && Tile->RingTiles.Num() < 1)
+        {
+            Tiles.Remove(TileId);
+        }
+    }
+
+    TArray<FIntPoint> BuildTileIds;
+    TArray<FTile*> BuildTiles;
+
+    for (const FIntPoint& TileId : DirtyTileIds)
+    {
+        if (FTile* Tile = Tiles.Find(TileId))
+        {
+            BuildTileIds.Emplace(TileId);
+            BuildTiles.Emplace(Tile);
+        }
+    }
+
+    ParallelFor(BuildTiles.Num(), [&](int32 i)
+    {
+        BuildTile(BuildTileIds[i], *BuildTiles[i]);
+    } );
+
+    ResolveComponents();
+
+    return DirtyTileIds.Num();
+}
+
+void FGULGridRasterCache::GetBoundaryCells(TArray<FIntPoint>& OutGridIds) const
+{
+    for (const auto& TilePair : Tiles)
+    {
+        OutGridIds.Append(TilePair.Value.BoundaryCells);
+    }
+}
+
+void FGULGridRasterCache::GetPointGroups(TArray<FGULIntPointGroup>& OutPointGroups) const
+{
+    const int32 GroupOffset = OutPointGroups.Num();
+    const int32 ComponentCount = Components.Num();
+
+    OutPointGroups.SetNum(GroupOffset+ComponentCount);
+
+    for (int32 i=0; i<ComponentCount; ++i)
+    {
+        OutPointGroups[GroupOffset+i].Points.Reserve(Components[i].Area);
+    }
+
+    // Gather tile fragments and interior tile cells in tile order
+
+    for (int32 ty=TileRangeMin.Y; ty<=TileRangeMax.Y; ++ty)
+    for (int32 tx=TileRangeMin.X; tx<=TileRangeMax.X; ++tx)
+    {
+        const FIntPoint TileId(tx, ty);
+
+        if (const FTile* Tile = Tiles.Find(TileId))
+        {
+            for (int32 GroupIt=0; GroupIt<Tile->PointGroups.Num(); ++GroupIt)
+            {
+                TArray<FIntPoint>& OutPoints(OutPointGroups[GroupOffset+Tile->ComponentIds[GroupIt]].Points);
+                OutPoints.Append(Tile->PointGroups[GroupIt].Points);
+            }
+        }
+        else
+        {
+            TArray<FIntPoint>& OutPoints(OutPointGroups[GroupOffset+GetInteriorTileComponent(TileId)].Points);
+
+            FIntPoint FillMin;
+            FIntPoint FillMax;
+            GetTileFillBounds(TileId, FillMin, FillMax);
+
+            for (int32 y=FillMin.Y; y<=FillMax.Y; ++y)
+            for (int32 x=FillMin.X; x<=FillMax.X; ++x)
+            {
+                OutPoints.Emplace(x, y);
+            }
+        }
+    }
+}
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridSDFRasterizer.h"
+#include "Async/ParallelFor.h"
+
+FGULGridSDFRasterizer::FGULGridSDFRasterizer(int32 InGridSizeX, int32 InGridSizeY)
+    : GridSize(FMath::Max(1, InGridSizeX), FMath::Max(1, InGridSizeY))
+    , ScanConverter(InGridSizeX, InGridSizeY)
+{
+}
+
+void FGULGridSDFRasterizer::Reset()
+{
+    Edges.Reset();
+    ScanConverter.Reset();
+}
+
+void FGULGridSDFRasterizer::AddRing(TArrayView<const FVector2D> Points)
+{
+    const int32 PointCount = Points.Num();
+
+    if (PointCount < 1)
+    {
+        return;
+    }
+
+    ScanConverter.AddRing(Points);
+
+    Edges.Reserve(Edges.Num()+PointCount);
+
+    FVector2D P1(Points[PointCount-1]);
+
+    for (int32 i=0; i<PointCount; ++i)
+    {
+        const FVector2D P0(P1);
+        P1 = Points[i];
+
+        const FVector2D P01(P1-P0);
+        const float LengthSq = P01.SizeSquared();
+
+        FEdge Edge;
+        Edge.P0 = P0;
+        Edge.P01 = P01;
+        Edge.InvLengthSq = (LengthSq > 0.f) ? 1.f/LengthSq : 0.f;
+        Edge.Bounds = FBox2D(ForceInit);
+        Edge.Bounds += P0;
+        Edge.Bounds += P1;
+
+        Edges.Emplace(Edge);
+    }
+}
+
+void FGULGridSDFRasterizer::AddPolyGroups(const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    for (const FGULVector2DGroup& PolyGroup : PolyGroups)
+    {
+        if (PolyGroup.Points.Num() > 0)
+        {
+            ScanConverter.AddShape();
+            AddRing(PolyGroup.Points);
+        }
+    }
+}
+
+void FGULGridSDFRasterizer::AddIndexedPolyGroups(
+    const TArray<FGULIndexedPolyGroup>& IndexGroups,
+    const TArray<FGULVector2DGroup>& PolyGroups
+    )
+{
+    for (const FGULIndexedPolyGroup& IndexGroup : IndexGroups)
+    {
+        if (! IndexGroup.IsValidIndexGroup(PolyGroups))
+        {
+            continue;
+        }
+
+        ScanConverter.AddShape();
+        AddRing(IndexGroup.GetOuter(PolyGroups).Points);
+
+        for (int32 i=0; i<IndexGroup.GetInnerNum(); ++i)
+        {
+            AddRing(IndexGroup.GetInner(PolyGroups, i).Points);
+        }
+    }
+}
+
+bool FGULGridSDFRasterizer::Generate(
+    TArray<float>& OutDistances,
+    FIntPoint& OutBoundsMin,
+    FIntPoint& OutBoundsMax,
+    float BandWidth,
+    int32 TileSize
+    ) const
+{
+    OutDistances.Reset();
+
+    if (! HasEdges() || BandWidth <= 0.f)
+    {
+        return false;
+    }
+
+    TileSize = FMath::Max(1, TileSize);
+
+    const FVector2D BandExtent(BandWidth, BandWidth);
+    const float BandWidthSq = BandWidth*BandWidth;
+
+    // Cell bounds of band expanded shape bounds
+
+    FBox2D ShapeBounds(ForceInit);
+
+    for (const FEdge& Edge : Edges)
+    {
+        ShapeBounds += Edge.Bounds;
+    }
+
+    auto GetCellId = [this](const FVector2D& Point)
+    {
+        return FIntPoint(
+            FMath::FloorToInt(Point.X / GridSize.X),
+            FMath::FloorToInt(Point.Y / GridSize.Y)
+            );
+    };
+
+    OutBoundsMin = GetCellId(ShapeBounds.Min-BandExtent);
+    OutBoundsMax = GetCellId(ShapeBounds.Max+BandExtent);
+
+    const FIntPoint BoundsMin(OutBoundsMin);
+    const int32 Stride = (OutBoundsMax.X-BoundsMin.X)+1;
+    const int32 RowCount = (OutBoundsMax.Y-BoundsMin.Y)+1;
+
+    const int32 TileCountX = FMath::DivideAndRoundUp(Stride, TileSize);
+    const int32 TileCountY = FMath::DivideAndRoundUp(RowCount, TileSize);
+    const int32 TileCount = TileCountX*TileCountY;
+
+    // Bin edges by overlapping tiles of band expanded edge bounds
+
+    auto GetTileRange = [&](const FEdge& Edge, FIntPoint& Tile0, FIntPoint& Tile1)
+    {
+        const FIntPoint Cell0(GetCellId(Edge.Bounds.Min-BandExtent) - BoundsMin);
+        const FIntPoint Cell1(GetCellId(Edge.Bounds.Max+BandExtent) - BoundsMin);
+
+        Tile0.X = FMath::Clamp(Cell0.X / TileSize, 0, TileCountX-1);
+        Tile0.Y = FMath::Clamp(Cell0.Y / TileSize, 0, TileCountY-1);
+        Tile1.X = FMath::Clamp(Cell1.X / TileSize, 0, TileCountX-1);
+        Tile1.Y = FMath::Clamp(Cell1.Y / TileSize, 0, TileCountY-1);
+    };
+
+    TArray<int32> TileOffsets;
+    TArray<int32> TileEdgeIndices;
+
+    TileOffsets.SetNumZeroed(TileCount+1);
+
+    for (const FEdge& Edge : Edges)
+    {
+        FIntPoint Tile0;
+        FIntPoint Tile1;
+        GetTileRange(Edge, Tile0, Tile1);
+
+        for (int32 ty=Tile0.Y; ty<=Tile1.Y; ++ty)
+        for (int32 tx=Tile0.X; tx<=Tile1.X; ++tx)
+        {
+            ++TileOffsets[tx + ty*TileCountX + 1];
+        }
+    }
+
+    for (int32 t=0; t<TileCount; ++t)
+    {
+        TileOffsets[t+1] += TileOffsets[t];
+    }
+
+    TArray<int32> TileCursors(TileOffsets.GetData(), TileCount);
+    TileEdgeIndices.SetNumUninitialized(TileOffsets[TileCount]);
+
+    for (int32 EdgeIndex=0; EdgeIndex<Edges.Num(); ++EdgeIndex)
+    {
+        FIntPoint Tile0;
+        FIntPoint Tile1;
+        GetTileRange(Edges[EdgeIndex], Tile0, Tile1);
+
+        for (int32 ty=Tile0.Y; ty<=Tile1.Y; ++ty)
+        for (int32 tx=Tile0.X; tx<=Tile1.X; ++tx)
+        {
+            TileEdgeIndices[TileCursors[tx + ty*TileCountX]++] = EdgeIndex;
+        }
+    }
+
+    // Rasterize unsigned band distances per tile
+
+    OutDistances.SetNumUninitialized(Stride*RowCount);
+
+    ParallelFor(TileCount, [&](int32 TileIndex)
+    {
+        const int32 x0 = (TileIndex % TileCountX) * TileSize;
+        const int32 y0 = (TileIndex / TileCountX) * TileSize;
+        const int32 x1 = FMath::Min(x0+TileSize, Stride);
+        const int32 y1 = FMath::Min(y0+TileSize, RowCount);
+
+        const int32 EdgeOffset = TileOffsets[TileIndex];
+        const int32 EdgeCount = TileOffsets[TileIndex+1]-EdgeOffset;
+        const int32* EdgeIndices = TileEdgeIndices.GetData()+EdgeOffset;
+
+        for (int32 y=y0; y<y1; ++y)
+        for (int32 x=x0; x<x1; ++x)
+        {
+            const FVector2D Center(
+                (BoundsMin.X+x+.5f) * GridSize.X,
+                (BoundsMin.Y+y+.5f) * GridSize.Y
+                );
+
+            float MinDistanceSq = BandWidthSq;
+
+            for (int32 i=0; i<EdgeCount; ++i)
+            {
+                const FEdge& Edge(Edges[EdgeIndices[i]]);
+
+                // Skip edges outside of cell band
+                if (Center.X < Edge.Bounds.Min.X-BandWidth || Center.X > Edge.Bounds.Max.X+BandWidth ||
+                    Center.Y < Edge.Bounds.Min.Y-BandWidth || Center.Y > Edge.Bounds.Max.Y+BandWidth)
+                {
+                    continue;
+                }
+
+                MinDistanceSq = FMath::Min(MinDistanceSq, GetDistanceSquared(Edge, Center));
+            }
+
+            OutDistances[x + y*Stride] = FMath::Sqrt(MinDistanceSq);
+        }
+    } );
+
+    // Negate distances of cells with centers inside shapes
+
+    TArray<FGULGridSpan> InsideSpans;
+    ScanConverter.GenerateSpans(InsideSpans, TileSize, false);
+
+    ParallelFor(InsideSpans.Num(), [&](int32 SpanIndex)
+    {
+        const FGULGridSpan& Span(InsideSpans[SpanIndex]);
+        const int32 RowIndex = (Span.Y-BoundsMin.Y)*Stride - BoundsMin.X;
+
+        for (int32 x=Span.X0; x<=Span.X1; ++x)
+        {
+            OutDistances[RowIndex+x] = -OutDistances[RowIndex+x];
+        }
+    } );
+
+    return true;
+}
@@ -0,0 +1,407 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridScanConverter.h"
+#include "Async/ParallelFor.h"
+#include "Grid/GULGridUtility.h"
+
+FGULGridScanConverter::FGULGridScanConverter(int32 InGridSizeX, int32 InGridSizeY)
+    : GridSize(FMath::Max(1, InGridSizeX), FMath::Max(1, InGridSizeY))
+{
+}
+
+void FGULGridScanConverter::Reset()
+{
+    Edges.Reset();
+    ShapeCount = 0;
+
+    MinY = BIG_NUMBER;
+    MaxY = -BIG_NUMBER;
+}
+
+int32 FGULGridScanConverter::AddShape()
+{
+    return ShapeCount++;
+}
+
+void FGULGridScanConverter::AddRing(TArrayView<const FVector2D> Points)
+{
+    const int32 PointCount = Points.Num();
+
+    if (PointCount < 1)
+    {
+        return;
+    }
+
+    // Make sure ring is assigned to a valid shape
+    if (ShapeCount < 1)
+    {
+        AddShape();
+    }
+
+    const int32 ShapeIndex = ShapeCount-1;
+
+    Edges.Reserve(Edges.Num()+PointCount);
+
+    FVector2D P1(Points[PointCount-1] / GridSize);
+
+    for (int32 i=0; i<PointCount; ++i)
+    {
+        const FVector2D P0(P1);
+        P1 = Points[i] / GridSize;
+
+        FEdge Edge;
+        Edge.P0 = (P0.Y <= P1.Y) ? P0 : P1;
+        Edge.P1 = (P0.Y <= P1.Y) ? P1 : P0;
+        Edge.ShapeIndex = ShapeIndex;
+
+        Edges.Emplace(Edge);
+
+        MinY = FMath::Min(MinY, Edge.P0.Y);
+        MaxY = FMath::Max(MaxY, Edge.P1.Y);
+    }
+}
+
+void FGULGridScanConverter::AddPolyGroups(const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    for (const FGULVector2DGroup& PolyGroup : PolyGroups)
+    {
+        if (PolyGroup.Points.Num() > 0)
+        {
+            AddShape();
+            AddRing(PolyGroup.Points);
+        }
+    }
+}
+
+void FGULGridScanConverter::AddIndexedPolyGroups(
+    const TArray<FGULIndexedPolyGroup>& IndexGroups,
+    const TArray<FGULVector2DGroup>& PolyGroups
+    )
+{
+    for (const FGULIndexedPolyGroup& IndexGroup : IndexGroups)
+    {
+        if (! IndexGroup.IsValidIndexGroup(PolyGroups))
+        {
+            continue;
+        }
+
+        AddShape();
+        AddRing(IndexGroup.GetOuter(PolyGroups).Points);
+
+        for (int32 i=0; i<IndexGroup.GetInnerNum(); ++i)
+        {
+            AddRing(IndexGroup.GetInner(PolyGroups, i).Points);
+        }
+    }
+}
+
+void FGULGridScanConverter::AddPolySoup(const FGULPolySoup& PolySoup)
+{
+    for (int32 i=0; i<PolySoup.GetRingNum(); ++i)
+    {
+        if (PolySoup.GetRingPointNum(i) > 0)
+        {
+            AddShape();
+            AddRing(PolySoup.GetRing(i));
+        }
+    }
+}
+
+void FGULGridScanConverter::GenerateSpans(
+    TArray<FGULGridSpan>& OutSpans,
+    int32 RowBandSize,
+    bool bIncludeEdgeCells
+    ) const
+{
+    OutSpans.Reset();
+
+    if (! HasEdges())
+    {
+        return;
+    }
+
+    RowBandSize = FMath::Max(1, RowBandSize);
+
+    const int32 RowMin = FMath::FloorToInt(MinY);
+    const int32 RowMax = FMath::FloorToInt(MaxY);
+    const int32 RowCount = RowMax-RowMin+1;
+    const int32 BandCount = FMath::DivideAndRoundUp(RowCount, RowBandSize);
+
+    // Bin edges by overlapping row bands
+
+    TArray<int32> BandOffsets;
+    TArray<int32> BandEdgeIndices;
+
+    BandOffsets.SetNumZeroed(BandCount+1);
+
+    for (const FEdge& Edge : Edges)
+    {
+        const int32 b0 = (FMath::FloorToInt(Edge.P0.Y)-RowMin) / RowBandSize;
+        const int32 b1 = (FMath::FloorToInt(Edge.P1.Y)-RowMin) / RowBandSize;
+
+        for (int32 b=b0; b<=b1; ++b)
+        {
+            ++BandOffsets[b+1];
+        }
+    }
+
+    for (int32 b=0; b<BandCount; ++b)
+    {
+        BandOffsets[b+1] += BandOffsets[b];
+    }
+
+    TArray<int32> BandCursors(BandOffsets.GetData(), BandCount);
+    BandEdgeIndices.SetNumUninitialized(BandOffsets[BandCount]);
+
+    for (int32 EdgeIndex=0; EdgeIndex<Edges.Num(); ++EdgeIndex)
+    {
+        const FEdge& Edge(Edges[EdgeIndex]);
+        const int32 b0 = (FMath::FloorToInt(Edge.P0.Y)-RowMin) / RowBandSize;
+        const int32 b1 = (FMath::FloorToInt(Edge.P1.Y)-RowMin) / RowBandSize;
+
+        for (int32 b=b0; b<=b1; ++b)
+        {
+            BandEdgeIndices[BandCursors[b]++] = EdgeIndex;
+        }
+    }
+
+    // Convert row bands
+
+    TArray< TArray<FGULGridSpan> > BandSpans;
+    BandSpans.SetNum(BandCount);
+
+    ParallelFor(BandCount, [&](int32 BandIndex)
+    {
+        const int32 Row0 = RowMin + BandIndex*RowBandSize;
+        const int32 Row1 = FMath::Min(Row0+RowBandSize-1, RowMax);
+        const int32 EdgeOffset = BandOffsets[BandIndex];
+
+        ConvertRowBand(
+            BandSpans[BandIndex],
+            TArrayView<const int32>(
+                BandEdgeIndices.GetData()+EdgeOffset,
+                BandOffsets[BandIndex+1]-EdgeOffset
+                ),
+            Row0,
+            Row1,
+            bIncludeEdgeCells
+            );
+    } );
+
+    // Gather band spans in row order
+
+    int32 SpanCount = 0;
+
+    for (const TArray<FGULGridSpan>& Spans : BandSpans)
+    {
+        SpanCount += Spans.Num();
+    }
+
+    OutSpans.Reserve(SpanCount);
+
+    for (const TArray<FGULGridSpan>& Spans : BandSpans)
+    {
+        OutSpans.Append(Spans);
+    }
+}
+
+void FGULGridScanConverter::GenerateSpans(
+    FGULGridSpanSet& OutSpanSet,
+    int32 RowBandSize,
+    bool bIncludeEdgeCells
+    ) const
+{
+    TArray<FGULGridSpan> Spans;
+    GenerateSpans(Spans, RowBandSize, bIncludeEdgeCells);
+    OutSpanSet.SetSpans(MoveTemp(Spans));
+}
+
+void FGULGridScanConverter::GenerateGridIds(
+    TArray<FIntPoint>& OutGridIds,
+    int32 RowBandSize,
+    bool bIncludeEdgeCells
+    ) const
+{
+    TArray<FGULGridSpan> Spans;
+    GenerateSpans(Spans, RowBandSize, bIncludeEdgeCells);
+    UGULGridUtility::ConvertSpansToPoints(OutGridIds, Spans);
+}
+
+void FGULGridScanConverter::ConvertRowBand(
+    TArray<FGULGridSpan>& OutSpans,
+    TArrayView<const int32> BandEdgeIndices,
+    int32 Row0,
+    int32 Row1,
+    bool bIncludeEdgeCells
+    ) const
+{
+    struct FCrossing
+    {
+        int32 ShapeIndex;
+        float X;
+
+        FORCEINLINE bool operator<(const FCrossing& Other) const
+        {
+            return (ShapeIndex != Other.ShapeIndex)
+                ? ShapeIndex < Other.ShapeIndex
+                : X < Other.X;
+        }
+    };
+
+    // Sort band edges by starting row for active edge table insertion
+
+    TArray<int32> SortedEdgeIndices(BandEdgeIndices.GetData(), BandEdgeIndices.Num());
+
+    SortedEdgeIndices.Sort([this](int32 a, int32 b)
+    {
+        return Edges[a].P0.Y < Edges[b].P0.Y;
+    } );
+
+    TArray<int32> ActiveEdges;
+    TArray<FCrossing> Crossings;
+    TArray<FIntPoint> Runs;
+
+    int32 NextEdge = 0;
+
+    for (int32 Row=Row0; Row<=Row1; ++Row)
+    {
+        const float RowMinY = static_cast<float>(Row);
+        const float RowMaxY = RowMinY+1.f;
+        const float SampleY = RowMinY+.5f;
+
+        // Update active edge table
+
+        while (NextEdge < SortedEdgeIndices.Num() && Edges[SortedEdgeIndices[NextEdge]].P0.Y < RowMaxY)
+        {
+            ActiveEdges.Emplace(SortedEdgeIndices[NextEdge]);
+            ++NextEdge;
+        }
+
+        ActiveEdges.RemoveAllSwap([this, RowMinY](int32 EdgeIndex)
+        {
+            return Edges[EdgeIndex].P1.Y < RowMinY;
+        } );
+
+        if (ActiveEdges.Num() < 1)
+        {
+            continue;
+        }
+
+        Crossings.Reset();
+        Runs.Reset();
+
+        for (int32 EdgeIndex : ActiveEdges)
+        {
+            const FEdge& Edge(Edges[EdgeIndex]);
+            const FVector2D& P0(Edge.P0);
+            const FVector2D& P1(Edge.P1);
+            const float DY = P1.Y-P0.Y;
+
+            // Boundary cells touched by the edge section within the row
+
+            float X0 = P0.X;
+            float X1 = P1.X;
+
+            if (DY > 0.f)
+            {
+                const float InvSlope = (P1.X-P0.X) / DY;
+                X0 = (P0.Y < RowMinY) ? P0.X + (RowMinY-P0.Y)*InvSlope : P0.X;
+                X1 = (P1.Y > RowMaxY) ? P0.X + (RowMaxY-P0.Y)*InvSlope : P1.X;
+
+                // Half-open sample line crossing
+                if (P0.Y <= SampleY && SampleY < P1.Y)
+                {
+                    Crossings.Emplace(FCrossing { Edge.ShapeIndex, P0.X + (SampleY-P0.Y)*InvSlope });
+                }
+            }
+
+            if (bIncludeEdgeCells)
+            {
+                Runs.Emplace(
+                    FMath::FloorToInt(FMath::Min(X0, X1)),
+                    FMath::FloorToInt(FMath::Max(X0, X1))
+                    );
+            }
+        }
+
+        // Interior cells with centers between shape crossing pairs
+
+        Crossings.Sort();
+
+        for (int32 i=1; i<Crossings.Num(); ++i)
+        {
+            const FCrossing& C0(Crossings[i-1]);
+            const FCrossing& C1(Crossings[i]);
+
+            if (C0.ShapeIndex == C1.ShapeIndex)
+            {
+                const int32 CX0 = FMath::CeilToInt(C0.X-.5f);
+                const int32 CX1 = FMath::FloorToInt(C1.X-.5f);
+
+                if (CX0 <= CX1)
+                {
+                    Runs.Emplace(CX0, CX1);
+                }
+
+                // Skip to the next crossing pair
+                ++i;
+            }
+        }
+
+        if (Runs.Num() < 1)
+        {
+            continue;
+        }
+
+        // Merge overlapping or adjacent runs into row spans
+
+        Runs.Sort([](const FIntPoint& a, const FIntPoint& b)
+        {
+            return a.X < b.X;
+        } );
+
+        FIntPoint Span(Runs[0]);
+
+        for (int32 i=1; i<Runs.Num(); ++i)
+        {
+            const FIntPoint& Run(Runs[i]);
+
+            if (Run.X <= Span.Y+1)
+            {
+                Span.Y = FMath::Max(Span.Y, Run.Y);
+            }
+            else
+            {
+                OutSpans.Emplace(Row, Span.X, Span.Y);
+                Span = Run;
+            }
+        }
+
+        OutSpans.Emplace(Row, Span.X, Span.Y);
+    }
+}
@@ -0,0 +1,400 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULGridSpanSet.h"
+#include "Grid/GULGridUtility.h"
+
+namespace GULGridSpanSet
+{
+    FORCEINLINE bool IsSpanLess(const FGULGridSpan& A, const FGULGridSpan& B)
+    {
+        return A.Y < B.Y || (A.Y == B.Y && A.X0 < B.X0);
+    }
+
+    // Span boundary k of a row, even boundaries are span starts and odd
+    // boundaries are exclusive span ends
+    FORCEINLINE int64 GetBoundary(const TArray<FGULGridSpan>& Spans, int32 RowStart, int32 k)
+    {
+        const FGULGridSpan& Span(Spans[RowStart + k/2]);
+        return (k & 1)
+            ? static_cast<int64>(Span.X1) + 1
+            : static_cast<int64>(Span.X0);
+    }
+}
+
+void FGULGridSpanSet::Reset()
+{
+    Spans.Reset();
+    CellCount = 0;
+}
+
+void FGULGridSpanSet::Normalize()
+{
+    const int32 SpanCount = Spans.Num();
+
+    // Skip sort if spans are already sorted, e.g. from scan conversion
+
+    bool bSorted = true;
+
+    for (int32 i=1; i<SpanCount; ++i)
+    {
+        if (GULGridSpanSet::IsSpanLess(Spans[i], Spans[i-1]))
+        {
+            bSorted = false;
+            break;
+        }
+    }
+
+    if (! bSorted)
+    {
+        Spans.Sort([](const FGULGridSpan& A, const FGULGridSpan& B)
+        {
+            return GULGridSpanSet::IsSpanLess(A, B);
+        } );
+    }
+
+    // Merge overlapping or touching spans
+
+    int32 WriteIndex = 0;
+
+    for (int32 i=0; i<SpanCount; ++i)
+    {
+        const FGULGridSpan Span(Spans[i]);
+
+        if (Span.X1 < Span.X0)
+        {
+            continue;
+        }
+
+        if (WriteIndex > 0)
+        {
+            FGULGridSpan& LastSpan(Spans[WriteIndex-1]);
+
+            if (LastSpan.Y == Span.Y && static_cast<int64>(Span.X0) <= static_cast<int64>(LastSpan.X1)+1)
+            {
+                LastSpan.X1 = FMath::Max(LastSpan.X1, Span.X1);
+                continue;
+            }
+        }
+
+        Spans[WriteIndex++] = Span;
+    }
+
+    Spans.SetNum(WriteIndex, false);
+
+    CellCount = 0;
+
+    for (const FGULGridSpan& Span : Spans)
+    {
+        CellCount += Span.Num();
+    }
+}
+
+int32 FGULGridSpanSet::UpperBound(const FIntPoint& Point) const
+{
+    int32 First = 0;
+    int32 Count = Spans.Num();
+
+    while (Count > 0)
+    {
+        const int32 Step = Count / 2;
+        const FGULGridSpan& Span(Spans[First+Step]);
+
+        if (Span.Y < Point.Y || (Span.Y == Point.Y && Span.X0 <= Point.X))
+        {
+            First += Step+1;
+            Count -= Step+1;
+        }
+        else
+        {
+            Count = Step;
+        }
+    }
+
+    return First;
+}
+
+void FGULGridSpanSet::SetSpans(const TArray<FGULGridSpan>& InSpans)
+{
+    Spans = InSpans;
+    Normalize();
+}
+
+void FGULGridSpanSet::SetSpans(TArray<FGULGridSpan>&& InSpans)
+{
+    Spans = MoveTemp(InSpans);
+    Normalize();
+}
+
+void FGULGridSpanSet::AddSpan(const FGULGridSpan& Span)
+{
+    if (Span.X1 < Span.X0)
+    {
+        return;
+    }
+
+    if (Spans.Num() > 0)
+    {
+        FGULGridSpan& LastSpan(Spans.Last());
+
+        // Out of order span, fall back to full normalization
+        if (GULGridSpanSet::IsSpanLess(Span, LastSpan))
+        {
+            Spans.Emplace(Span);
+            Normalize();
+            return;
+        }
+
+        // Extend last span
+        if (LastSpan.Y == Span.Y && static_cast<int64>(Span.X0) <= static_cast<int64>(LastSpan.X1)+1)
+        {
+            if (Span.X1 > LastSpan.X1)
+            {
+                CellCount += Span.X1-LastSpan.X1;
+                LastSpan.X1 = Span.X1;
+            }
+            return;
+        }
+    }
+
+    Spans.Emplace(Span);
+    CellCount += Span.Num();
+}
+
+bool FGULGridSpanSet::Contains(const FIntPoint& Point) const
+{
+    const int32 SpanIndex = UpperBound(Point)-1;
+
+    if (SpanIndex < 0)
+    {
+        return false;
+    }
+
+    const FGULGridSpan& Span(Spans[SpanIndex]);
+    return Span.Y == Point.Y && Point.X <= Span.X1;
+}
+
+bool FGULGridSpanSet::GetBounds(FIntPoint& OutBoundsMin, FIntPoint& OutBoundsMax) const
+{
+    if (Spans.Num() < 1)
+    {
+        return false;
+    }
+
+    OutBoundsMin = FIntPoint(MAX_int32, Spans[0].Y);
+    OutBoundsMax = FIntPoint(MIN_int32, Spans.Last().Y);
+
+    for (const FGULGridSpan& Span : Spans)
+    {
+        OutBoundsMin.X = FMath::Min(OutBoundsMin.X, Span.X0);
+        OutBoundsMax.X = FMath::Max(OutBoundsMax.X, Span.X1);
+    }
+
+    return true;
+}
+
+void FGULGridSpanSet::SetPoints(TArrayView<const FIntPoint> Points)
+{
+    Reset();
+
+    TArray<FIntPoint> SortedPoints(Points.GetData(), Points.Num());
+    UGULGridUtility::SortUniqueGridIds(SortedPoints, EGULGridOrder::RowMajor);
+
+    // Sorted unique points only extend or start spans
+
+    for (const FIntPoint& Point : SortedPoints)
+    {
+        if (Spans.Num() > 0)
+        {
+            FGULGridSpan& LastSpan(Spans.Last());
+
+            if (LastSpan.Y == Point.Y && LastSpan.X1+1 == Point.X)
+            {
+                LastSpan.X1 = Point.X;
+                continue;
+            }
+        }
+
+        Spans.Emplace(Point.Y, Point.X, Point.X);
+    }
+
+    CellCount = SortedPoints.Num();
+}
+
+void FGULGridSpanSet::ForEach(TFunctionRef<void(const FIntPoint&)> Callback) const
+{
+    for (const FGULGridSpan& Span : Spans)
+    {
+        for (int32 x=Span.X0; x<=Span.X1; ++x)
+        {
+            Callback(FIntPoint(x, Span.Y));
+        }
+    }
+}
+
+void FGULGridSpanSet::ToPoints(TArray<FIntPoint>& OutPoints) const
+{
+    OutPoints.Reset(CellCount);
+
+    for (const FGULGridSpan& Span : Spans)
+    {
+        for (int32 x=Span.X0; x<=Span.X1; ++x)
+        {
+            OutPoints.Emplace(x, Span.Y);
+        }
+    }
+}
+
+void FGULGridSpanSet::Combine(
+    FGULGridSpanSet& OutSet,
+    const FGULGridSpanSet& A,
+    const FGULGridSpanSet& B,
+    EOperation Operation
+    )
+{
+    const TArray<FGULGridSpan>& SpansA(A.Spans);
+    const TArray<FGULGridSpan>& SpansB(B.Spans);
+    const int32 SpanCountA = SpansA.Num();
+    const int32 SpanCountB = SpansB.Num();
+
+    TArray<FGULGridSpan> OutSpans;
+    OutSpans.Reserve(Operation == EOperation::Union ? SpanCountA+SpanCountB : SpanCountA);
+
+    int32 RowStartA = 0;
+    int32 RowStartB = 0;
+
+    while (RowStartA < SpanCountA || RowStartB < SpanCountB)
+    {
+        // Find next row and its span ranges on both sets
+
+        const int32 Y = (RowStartB >= SpanCountB || (RowStartA < SpanCountA && SpansA[RowStartA].Y <= SpansB[RowStartB].Y))
+            ? SpansA[RowStartA].Y
+            : SpansB[RowStartB].Y;
+
+        int32 RowEndA = RowStartA;
+        int32 RowEndB = RowStartB;
+
+        while (RowEndA < SpanCountA && SpansA[RowEndA].Y == Y)
+        {
+            ++RowEndA;
+        }
+
+        while (RowEndB < SpanCountB && SpansB[RowEndB].Y == Y)
+        {
+            ++RowEndB;
+        }
+
+        const bool bHasRowA = RowEndA > RowStartA;
+        const bool bHasRowB = RowEndB > RowStartB;
+
+        if (bHasRowA && bHasRowB)
+        {
+            // Sweep span boundaries of both rows, boundary counts give
+            // inside states of each set
+
+            const int32 BoundaryCountA = (RowEndA-RowStartA) * 2;
+            const int32 BoundaryCountB = (RowEndB-RowStartB) * 2;
+
+            int32 ka = 0;
+            int32 kb = 0;
+            int64 SpanStart = 0;
+            bool bInside = false;
+
+            while (ka < BoundaryCountA || kb < BoundaryCountB)
+            {
+                const int64 BoundaryA = ka < BoundaryCountA ? GULGridSpanSet::GetBoundary(SpansA, RowStartA, ka) : MAX_int64;
+                const int64 BoundaryB = kb < BoundaryCountB ? GULGridSpanSet::GetBoundary(SpansB, RowStartB, kb) : MAX_int64;
+                const int64 X = FMath::Min(BoundaryA, BoundaryB);
+
+                ka += (BoundaryA == X) ? 1 : 0;
+                kb += (BoundaryB == X) ? 1 : 0;
+
+                const bool bInsideA = (ka & 1) != 0;
+                const bool bInsideB = (kb & 1) != 0;
+                bool bInsideOut;
+
+                switch (Operation)
+                {
+                    case EOperation::Intersection:
+                        bInsideOut = bInsideA && bInsideB;
+                        break;
+
+                    case EOperation::Difference:
+                        bInsideOut = bInsideA && ! bInsideB;
+                        break;
+
+                    case EOperation::Union:
+                    default:
+                        bInsideOut = bInsideA || bInsideB;
+                        break;
+                }
+
+                if (bInsideOut != bInside)
+                {
+                    if (bInsideOut)
+                    {
+                        SpanStart = X;
+                    }
+                    else
+                    {
+                        OutSpans.Emplace(Y, static_cast<int32>(SpanStart), static_cast<int32>(X-1));
+                    }
+
+                    bInside = bInsideOut;
+                }
+            }
+        }
+        else
+        if (bHasRowA)
+        {
+            // Row only on A, kept by union and difference
+            if (Operation != EOperation::Intersection)
+            {
+                OutSpans.Append(SpansA.GetData()+RowStartA, RowEndA-RowStartA);
+            }
+        }
+        else
+        {
+            // Row only on B, kept by union
+            if (Operation == EOperation::Union)
+            {
+                OutSpans.Append(SpansB.GetData()+RowStartB, RowEndB-RowStartB);
+            }
+        }
+
+        RowStartA = RowEndA;
+        RowStartB = RowEndB;
+    }
+
+    OutSet.Spans = MoveTemp(OutSpans);
+    OutSet.CellCount = 0;
+
+    for (const FGULGridSpan& Span : OutSet.Spans)
+    {
+        OutSet.CellCount += Span.Num();
+    }
+}
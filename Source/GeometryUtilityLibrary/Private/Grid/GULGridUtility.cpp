@@ -27,9 +27,50 @@
 
 #include "Grid/GULGridUtility.h"
 #include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
 #include "GeometryUtilityLibrary.h"
 #include "GULMathLibrary.h"
+#include "GULSortUtility.h"
 #include "Poly/GULPolyUtilityLibrary.h"
+#include "Poly/GULPreparedPoly.h"
+#include "Grid/GULGridScanConverter.h"
+#include "Grid/GULGridComponentLabeler.h"
+#include "Grid/GULGridDistanceTransform.h"
+#include "Grid/GULGridSDFRasterizer.h"
+
+#define GUL_GRID_VISIT_PARALLEL_BATCH_SIZE 1024
+#define GUL_GRID_INTERSECT_BATCH_SIZE 64
+
+namespace GULGridUtility
+{
+    // Boundary cell source adapters, boundary cells are either a point array
+    // or a sparse grid
+
+    template<typename FCallback>
+    FORCEINLINE void ForEachBoundaryCell(const TArray<FIntPoint>& BoundaryPoints, FCallback&& Callback)
+    {
+        for (const FIntPoint& BoundaryPoint : BoundaryPoints)
+        {
+            Callback(BoundaryPoint);
+        }
+    }
+
+    template<typename FCallback>
+    FORCEINLINE void ForEachBoundaryCell(const FGULSparseGrid& BoundaryGrid, FCallback&& Callback)
+    {
+        BoundaryGrid.ForEach(Callback);
+    }
+
+    FORCEINLINE void SetBoundaryCells(FGULGridComponentLabeler& Labeler, const TArray<FIntPoint>& BoundaryPoints)
+    {
+        Labeler.SetBoundaryPoints(BoundaryPoints);
+    }
+
+    FORCEINLINE void SetBoundaryCells(FGULGridComponentLabeler& Labeler, const FGULSparseGrid& BoundaryGrid)
+    {
+        Labeler.SetBoundaryGrid(BoundaryGrid);
+    }
+}
 
 int32 UGULGridUtility::GroupGridsByDimension(
     TArray<FIntPoint>& OutGroupIds,
@@ -51,20 +92,18 @@ int32 UGULGridUtility::GroupGridsByDimension(
         TArray<FIntPoint> GridIds;
     };
 
-    TMap< uint32, FGroupData > GroupMap;
+    TMap< uint64, FGroupData > GroupMap;
 
     for (const FIntPoint& GridId : InGridIds)
     {
-        FIntPoint GroupId;
-        GroupId.X = FMath::FloorToInt(static_cast<float>(GridId.X) / GroupDimensionX);
-        GroupId.Y = FMath::FloorToInt(static_cast<float>(GridId.Y) / GroupDimensionY);
-        uint32 Hash = UGULMathLibrary::GetHash(GroupId);
+        const FIntPoint GroupId(UGULMathLibrary::FloorDiv(GridId, GroupDimensionX, GroupDimensionY));
+        const uint64 GroupKey = UGULMathLibrary::PackGridKey(GroupId);
 
-        FGroupData* GroupData(GroupMap.Find(Hash));
+        FGroupData* GroupData(GroupMap.Find(GroupKey));
 
         if (! GroupData)
         {
-            GroupData = &GroupMap.Emplace(Hash);
+            GroupData = &GroupMap.Emplace(GroupKey);
             GroupData->GroupId = GroupId;
         }
 
@@ -118,9 +157,7 @@ int32 UGULGridUtility::GroupGridsByDimensionAndBounds(
 
     for (const FIntPoint& GridId : InGridIds)
     {
-        FIntPoint GroupId;
-        GroupId.X = FMath::FloorToInt(static_cast<float>(GridId.X) / GroupDimensionX);
-        GroupId.Y = FMath::FloorToInt(static_cast<float>(GridId.Y) / GroupDimensionY);
+        const FIntPoint GroupId(UGULMathLibrary::FloorDiv(GridId, GroupDimensionX, GroupDimensionY));
 
         if (IsOnBounds(GroupId, GroupBoundsMin, GroupBoundsMax))
         {
@@ -148,92 +185,238 @@ int32 UGULGridUtility::GroupGridsByDimensionAndBounds(
     return GroupCount;
 }
 
-void UGULGridUtility::PointFill(
-    TArray<FIntPoint>& OutPoints,
-    const TSet<int32>& BoundaryIndexSet,
-    const FIntPoint& BoundsMin,
-    const FIntPoint& BoundsMax,
-    const FIntPoint& FillTargetPoint,
-    TSet<int32>* VisitedSet
+int32 UGULGridUtility::GroupGridsByDimensionSorted(
+    TArray<FIntPoint>& OutGroupIds,
+    TArray<FGULIntPointGroup>& OutGridIdGroups,
+    const TArray<FIntPoint>& InGridIds,
+    int32 GroupDimensionX,
+    int32 GroupDimensionY,
+    EGULGridOrder Order
     )
 {
-    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
-    const int32 FillTargetIndex = GetGridIndex(FillTargetPoint, BoundsMin, Size);
+    TArray<FIntPoint> GroupIds;
+    TArray<int32> GroupOffsets;
+    TArray<FIntPoint> GridIds;
 
-    check(Size > 0);
+    const int32 GroupCount = GroupGridRangesByDimension(
+        GroupIds,
+        GroupOffsets,
+        GridIds,
+        InGridIds,
+        GroupDimensionX,
+        GroupDimensionY,
+        Order
+        );
 
-    OutPoints.Reset(FMath::Max(1, (Size*Size) / 4));
-    OutPoints.Emplace(FillTargetPoint);
+    if (GroupCount < 1)
+    {
+        return 0;
+    }
 
-    TQueue<FIntPoint> VisitQueue;
-    TSet<int32> LocalVisitedSet;
+    OutGroupIds.Append(GroupIds);
+    OutGridIdGroups.Reserve(OutGridIdGroups.Num()+GroupCount);
 
-    if (! VisitedSet)
+    for (int32 i=0; i<GroupCount; ++i)
     {
-        VisitedSet = &LocalVisitedSet;
+        const int32 GroupOffset = GroupOffsets[i];
+
+        OutGridIdGroups.AddDefaulted();
+        OutGridIdGroups.Last().Points.Append(
+            GridIds.GetData()+GroupOffset,
+            GroupOffsets[i+1]-GroupOffset
+            );
     }
 
-    // Visit starting index
-    VisitQueue.Enqueue(FillTargetPoint);
-    VisitedSet->Emplace(FillTargetIndex);
+    return GroupCount;
+}
 
-    const FIntPoint Offsets[4] = {
-        FIntPoint(-1,  0), // W
-        FIntPoint( 0, -1), // S
-        FIntPoint( 1,  0), // E
-        FIntPoint( 0,  1)  // N
-        };
+int32 UGULGridUtility::GroupGridRangesByDimension(
+    TArray<FIntPoint>& OutGroupIds,
+    TArray<int32>& OutGroupOffsets,
+    TArray<FIntPoint>& OutGridIds,
+    const TArray<FIntPoint>& InGridIds,
+    int32 GroupDimensionX,
+    int32 GroupDimensionY,
+    EGULGridOrder Order
+    )
+{
+    OutGroupIds.Reset();
+    OutGroupOffsets.Reset();
+    OutGridIds.Reset();
 
-    // Visit cells in queue
-    while (! VisitQueue.IsEmpty())
+    if (GroupDimensionX < 1 || GroupDimensionY < 1)
     {
-        FIntPoint VisitPoint;
-        VisitQueue.Dequeue(VisitPoint);
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GroupGridRangesByDimension() ABORTED, INVALID GROUP DIMENSION"));
+        return 0;
+    }
 
-        for (int32 i=0; i<4; ++i)
+    const int32 GridCount = InGridIds.Num();
+
+    // Generate group keys
+
+    TArray<uint64> GroupKeys;
+    GroupKeys.SetNumUninitialized(GridCount);
+
+    for (int32 i=0; i<GridCount; ++i)
+    {
+        const FIntPoint GroupId(UGULMathLibrary::FloorDiv(InGridIds[i], GroupDimensionX, GroupDimensionY));
+
+        GroupKeys[i] = GetGridOrderKey(GroupId, Order);
+    }
+
+    // Sort grid ids by group keys
+
+    TArray<int32> SortedIndices;
+    FGULSortUtility::RadixSortIndices(SortedIndices, TArrayView<const uint64>(GroupKeys));
+
+    // Generate group ranges
+
+    OutGridIds.SetNumUninitialized(GridCount);
+
+    for (int32 i=0; i<GridCount; ++i)
+    {
+        const int32 GridIndex = SortedIndices[i];
+        const uint64 GroupKey = GroupKeys[GridIndex];
+
+        OutGridIds[i] = InGridIds[GridIndex];
+
+        if (i == 0 || GroupKey != GroupKeys[SortedIndices[i-1]])
         {
-            FIntPoint NeighbourPoint(VisitPoint+Offsets[i]);
-            int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
+            OutGroupOffsets.Emplace(i);
+            OutGroupIds.Emplace(GetGridOrderPoint(GroupKey, Order));
+        }
+    }
+
+    OutGroupOffsets.Emplace(GridCount);
+
+    return OutGroupIds.Num();
+}
+
+int32 UGULGridUtility::GroupGridRangesByDimension(
+    TArray<FIntPoint>& OutGroupIds,
+    TArray<int32>& OutGroupOffsets,
+    TArray<FIntPoint>& OutGridIds,
+    const FGULSparseGrid& InGrid,
+    int32 GroupDimensionX,
+    int32 GroupDimensionY,
+    EGULGridOrder Order
+    )
+{
+    OutGroupIds.Reset();
+    OutGroupOffsets.Reset();
+    OutGridIds.Reset();
+
+    if (GroupDimensionX < 1 || GroupDimensionY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GroupGridRangesByDimension() ABORTED, INVALID GROUP DIMENSION"));
+        return 0;
+    }
 
-            if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax) ||
-                BoundaryIndexSet.Contains(NeighbourIndex) ||
-                VisitedSet->Contains(NeighbourIndex))
+    // Split chunk rows into cell runs of a single group. Runs are generated
+    // in sparse grid iteration order, each run holds a chunk row cell mask.
+
+    TArray<uint64> RunKeys;
+    TArray<FIntPoint> RunOrigins;
+    TArray<uint64> RunBits;
+
+    TArray<int32> ChunkIndices;
+    InGrid.GetSortedChunkIndices(ChunkIndices);
+
+    const TArray<FGULSparseGrid::FChunk>& Chunks(InGrid.GetChunks());
+
+    for (int32 ChunkIndex : ChunkIndices)
+    {
+        const FGULSparseGrid::FChunk& Chunk(Chunks[ChunkIndex]);
+
+        if (Chunk.IsEmpty())
+        {
+            continue;
+        }
+
+        const FIntPoint ChunkOrigin(FGULSparseGrid::GetChunkOrigin(Chunk.ChunkId));
+
+        for (int32 y=0; y<FGULSparseGrid::ChunkSize; ++y)
+        {
+            const FIntPoint RowOrigin(ChunkOrigin.X, ChunkOrigin.Y+y);
+            const int32 GroupY = UGULMathLibrary::FloorDiv(RowOrigin.Y, GroupDimensionY);
+
+            uint64 Bits = Chunk.Rows[y];
+
+            while (Bits)
             {
-                continue;
+                // Mask row cells up to the last cell of the first cell group
+
+                const int32 X0 = FGULSparseGrid::CountTrailingZeros(Bits);
+                const int32 GroupX = UGULMathLibrary::FloorDiv(RowOrigin.X+X0, GroupDimensionX);
+                const int64 GroupEndX = (static_cast<int64>(GroupX)+1) * GroupDimensionX - 1;
+                const int32 X1 = static_cast<int32>(FMath::Min<int64>(GroupEndX-RowOrigin.X, FGULSparseGrid::ChunkMask));
+
+                const uint64 RunMask = (X1 < FGULSparseGrid::ChunkMask)
+                    ? Bits & ((1ull << (X1+1)) - 1)
+                    : Bits;
+
+                RunKeys.Emplace(GetGridOrderKey(FIntPoint(GroupX, GroupY), Order));
+                RunOrigins.Emplace(RowOrigin);
+                RunBits.Emplace(RunMask);
+
+                Bits &= ~RunMask;
             }
+        }
+    }
 
-            // Add point to the visited set
-            VisitedSet->Emplace(NeighbourIndex);
-            VisitQueue.Enqueue(NeighbourPoint);
+    // Sort runs by group keys, stable sort keeps iteration order within groups
 
-            OutPoints.Emplace(NeighbourPoint);
+    TArray<int32> SortedIndices;
+    FGULSortUtility::RadixSortIndices(SortedIndices, TArrayView<const uint64>(RunKeys));
+
+    // Generate group ranges
+
+    OutGridIds.Reserve(InGrid.Num());
+
+    for (int32 i=0; i<SortedIndices.Num(); ++i)
+    {
+        const int32 RunIndex = SortedIndices[i];
+        const uint64 GroupKey = RunKeys[RunIndex];
+        const FIntPoint& RowOrigin(RunOrigins[RunIndex]);
+
+        if (i == 0 || GroupKey != RunKeys[SortedIndices[i-1]])
+        {
+            OutGroupOffsets.Emplace(OutGridIds.Num());
+            OutGroupIds.Emplace(GetGridOrderPoint(GroupKey, Order));
+        }
+
+        for (uint64 Bits=RunBits[RunIndex]; Bits; Bits&=Bits-1)
+        {
+            OutGridIds.Emplace(RowOrigin.X+FGULSparseGrid::CountTrailingZeros(Bits), RowOrigin.Y);
         }
     }
 
-    OutPoints.Shrink();
+    OutGroupOffsets.Emplace(OutGridIds.Num());
+
+    return OutGroupIds.Num();
 }
 
-void UGULGridUtility::PointFillMulti(
+template<typename FCellStates>
+void UGULGridUtility::PointFill(
     TArray<FIntPoint>& OutPoints,
-    const FIntPoint& BoundsMin,
-    const FIntPoint& BoundsMax,
-    const TArray<FIntPoint>& TargetPoints,
-    TFunction<bool(int32, FIntPoint)> VisitCallback
+    FCellStates& CellStates,
+    FGULGridPointQueue& VisitQueue,
+    const FIntPoint& FillTargetPoint
     )
 {
-    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
+    const int32 Size = CellStates.GetStride();
+    const int32 FillTargetIndex = CellStates.GetIndex(FillTargetPoint);
 
     check(Size > 0);
+    check(CellStates.IsOnBounds(FillTargetPoint));
 
-    TQueue<FIntPoint> VisitQueue;
-    TSet<int32> VisitedSet;
+    OutPoints.Reset(FMath::Max(1, (Size*Size) / 4));
+    OutPoints.Emplace(FillTargetPoint);
 
-    // Visit target points
-    for (const FIntPoint& TargetPoint : TargetPoints)
-    {
-        VisitQueue.Enqueue(TargetPoint);
-        VisitedSet.Emplace(GetGridIndex(TargetPoint, BoundsMin, Size));
-    }
+    // Visit starting index
+    VisitQueue.Reset();
+    VisitQueue.Enqueue(FillTargetPoint);
+    CellStates.SetVisited(FillTargetIndex);
 
     const FIntPoint Offsets[4] = {
         FIntPoint(-1,  0), // W
@@ -242,7 +425,7 @@ void UGULGridUtility::PointFillMulti(
         FIntPoint( 0,  1)  // N
         };
 
-    // Visit target point neighbours
+    // Visit cells in queue
     while (! VisitQueue.IsEmpty())
     {
         FIntPoint VisitPoint;
@@ -251,203 +434,215 @@ void UGULGridUtility::PointFillMulti(
         for (int32 i=0; i<4; ++i)
         {
             FIntPoint NeighbourPoint(VisitPoint+Offsets[i]);
-            int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
 
-            // Skip visited or out-of-bounds points
-            if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax) ||
-                VisitedSet.Contains(NeighbourIndex))
+            if (! CellStates.IsOnBounds(NeighbourPoint))
             {
                 continue;
             }
 
-            if (! VisitCallback || VisitCallback(NeighbourIndex, NeighbourPoint))
-            {
-                // Add point to the visited set
-                VisitedSet.Emplace(NeighbourIndex);
-                VisitQueue.Enqueue(NeighbourPoint);
+            int32 NeighbourIndex = CellStates.GetIndex(NeighbourPoint);
 
-                OutPoints.Emplace(NeighbourPoint);
+            if (CellStates.IsBoundaryOrVisited(NeighbourIndex))
+            {
+                continue;
             }
+
+            // Mark point as visited
+            CellStates.SetVisited(NeighbourIndex);
+            VisitQueue.Enqueue(NeighbourPoint);
+
+            OutPoints.Emplace(NeighbourPoint);
         }
     }
+
+    OutPoints.Shrink();
 }
 
-void UGULGridUtility::VisitPoints(
-    const FIntPoint& BoundsMin,
-    const FIntPoint& BoundsMax,
-    const TArray<FIntPoint>& TargetPoints,
-    TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+template<typename FCellStates>
+void UGULGridUtility::SpanFill(
+    TArray<FGULGridSpan>& OutSpans,
+    FCellStates& CellStates,
+    TArray<FIntPoint>& SeedStack,
+    const FIntPoint& FillTargetPoint
     )
 {
-    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
+    const int32 Size = CellStates.GetStride();
+    const FIntPoint& BoundsMin(CellStates.GetBoundsMin());
+    const FIntPoint& BoundsMax(CellStates.GetBoundsMax());
 
     check(Size > 0);
+    check(CellStates.IsOnBounds(FillTargetPoint));
 
-    TQueue<FIntPoint> VisitQueue0;
-    TQueue<FIntPoint> VisitQueue1;
+    OutSpans.Reset();
 
-    TSet<int32> VisitedSet;
+    SeedStack.Reset();
+    SeedStack.Emplace(FillTargetPoint);
 
-    // Visit target points
-    for (const FIntPoint& TargetPoint : TargetPoints)
+    while (SeedStack.Num() > 0)
     {
-        int32 TargetIndex = GetGridIndex(TargetPoint, BoundsMin, Size);
+        const FIntPoint Seed(SeedStack.Pop(false));
+        const int32 RowIndex = CellStates.GetIndex(FIntPoint(BoundsMin.X, Seed.Y)) - BoundsMin.X;
 
-        if (! IsOnBounds(TargetPoint, BoundsMin, BoundsMax) ||
-            VisitedSet.Contains(TargetIndex))
+        // Seed already filled by another span, skip
+        if (CellStates.IsBoundaryOrVisited(RowIndex+Seed.X))
         {
             continue;
         }
 
-        if (! VisitCallback || VisitCallback(TargetIndex, TargetPoint, 0))
+        // Expand span to the west and east
+
+        int32 X0 = Seed.X;
+        int32 X1 = Seed.X;
+
+        while (X0 > BoundsMin.X && ! CellStates.IsBoundaryOrVisited(RowIndex+X0-1))
         {
-            // Add point to the visited set
-            VisitedSet.Emplace(TargetIndex);
-            VisitQueue0.Enqueue(TargetPoint);
+            --X0;
         }
-    }
 
-    const FIntPoint Offsets[4] = {
-        FIntPoint(-1,  0), // W
-        FIntPoint( 0, -1), // S
-        FIntPoint( 1,  0), // E
-        FIntPoint( 0,  1)  // N
-        };
+        while (X1 < BoundsMax.X && ! CellStates.IsBoundaryOrVisited(RowIndex+X1+1))
+        {
+            ++X1;
+        }
 
-    TQueue<FIntPoint>* CurVisitQueue(&VisitQueue1);
-    TQueue<FIntPoint>* NextVisitQueue(&VisitQueue0);
-    int32 Iteration = 1;
+        CellStates.SetVisitedRange(RowIndex+X0, X1-X0+1);
+        OutSpans.Emplace(Seed.Y, X0, X1);
 
-    while (! NextVisitQueue->IsEmpty())
-    {
-        Swap(CurVisitQueue, NextVisitQueue);
+        // Push a seed for each open run on the south and north rows
 
-        // Visit target point neighbours
-        while (! CurVisitQueue->IsEmpty())
+        for (int32 dy=-1; dy<=1; dy+=2)
         {
-            FIntPoint VisitPoint;
-            CurVisitQueue->Dequeue(VisitPoint);
+            const int32 Y = Seed.Y+dy;
 
-            for (int32 i=0; i<4; ++i)
+            if (Y < BoundsMin.Y || Y > BoundsMax.Y)
             {
-                FIntPoint NeighbourPoint(VisitPoint+Offsets[i]);
-                int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
+                continue;
+            }
 
-                // Skip visited or out-of-bounds points
-                if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax) ||
-                    VisitedSet.Contains(NeighbourIndex))
-                {
-                    continue;
-                }
+            const int32 AdjacentRowIndex = RowIndex + dy*Size;
+            bool bOnOpenRun = false;
 
-                if (! VisitCallback || VisitCallback(NeighbourIndex, NeighbourPoint, Iteration))
+            for (int32 x=X0; x<=X1; ++x)
+            {
+                const bool bIsOpen = ! CellStates.IsBoundaryOrVisited(AdjacentRowIndex+x);
+
+                if (bIsOpen && ! bOnOpenRun)
                 {
-                    // Add point to the visited set
-                    VisitedSet.Emplace(NeighbourIndex);
-                    NextVisitQueue->Enqueue(NeighbourPoint);
+                    SeedStack.Emplace(x, Y);
                 }
+
+                bOnOpenRun = bIsOpen;
             }
         }
-
-        ++Iteration;
     }
 }
 
-bool UGULGridUtility::GridFillByPoint(
+template<typename FCellStates>
+void UGULGridUtility::PointFillByMode(
     TArray<FIntPoint>& OutPoints,
-    const TArray<FIntPoint>& BoundaryPoints,
-    const FIntPoint& FillTargetPoint
+    FCellStates& CellStates,
+    FGULGridScratch& Scratch,
+    const FIntPoint& FillTargetPoint,
+    EGULGridFillMode FillMode
     )
 {
-    if (BoundaryPoints.Num() < 1)
+    // Single target fills gain nothing from full grid labeling,
+    // labeling mode uses scanline fill instead
+    if (FillMode == EGULGridFillMode::Scanline ||
+        FillMode == EGULGridFillMode::Labeling)
     {
-        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, EMPTY BOUNDARY POINTS"));
-        return false;
+        SpanFill(Scratch.Spans, CellStates, Scratch.SeedStack, FillTargetPoint);
+        ConvertSpansToPoints(OutPoints, Scratch.Spans);
     }
-
-    FIntPoint BoundsMin;
-    FIntPoint BoundsMax;
-    int32 Size;
-
-    GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
-
-    if (! IsOnBounds(FillTargetPoint, BoundsMin, BoundsMax))
+    else
     {
-        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, OUT-OF-BOUND FILL TARGET POINT"));
-        return false;
+        PointFill(OutPoints, CellStates, Scratch.VisitQueue, FillTargetPoint);
     }
+}
 
-    TSet<int32> BoundaryIndexSet;
-    const int32 FillTargetIndex = GetGridIndex(FillTargetPoint, BoundsMin, Size);
+template<typename FCellStates, typename FBoundaryCells>
+void UGULGridUtility::VisitIsolatedFillTargets(
+    FCellStates& CellStates,
+    const FBoundaryCells& BoundaryCells,
+    TFunctionRef<void(const FIntPoint&)> FillCallback
+    )
+{
+    const FIntPoint Offsets[4] = {
+        FIntPoint(-1,  0), // W
+        FIntPoint( 0, -1), // S
+        FIntPoint( 1,  0), // E
+        FIntPoint( 0,  1)  // N
+        };
 
-    for (const FIntPoint& BoundaryPoint : BoundaryPoints)
+    GULGridUtility::ForEachBoundaryCell(BoundaryCells, [&](const FIntPoint& BoundaryPoint)
     {
-        int32 GridIndex = GetGridIndex(BoundaryPoint, BoundsMin, Size);
-        BoundaryIndexSet.Emplace(GridIndex);
-    }
+        for (int32 i=0; i<4; ++i)
+        {
+            FIntPoint NeighbourPoint(BoundaryPoint+Offsets[i]);
 
-    if (BoundaryIndexSet.Contains(FillTargetIndex))
-    {
-        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, FILL TARGET POINT IS A BOUNDARY POINT"));
-        return false;
-    }
+            if (! CellStates.IsOnBounds(NeighbourPoint) ||
+                CellStates.IsBoundaryOrVisited(CellStates.GetIndex(NeighbourPoint)))
+            {
+                continue;
+            }
 
-    PointFill(
-        OutPoints,
-        BoundaryIndexSet,
-        BoundsMin,
-        BoundsMax,
-        FillTargetPoint
-        );
-    
-    return true;
+            FillCallback(NeighbourPoint);
+        }
+    } );
 }
 
-bool UGULGridUtility::GridFillBoundsByPoints(
-    TArray<FIntPoint>& OutPoints,
-    const TArray<FIntPoint>& InTargetPoints,
-    FIntPoint BoundsMin,
-    FIntPoint BoundsMax,
-    TFunction<bool(int32, FIntPoint)> FilterCallback
+template<typename FBoundaryCells>
+void UGULGridUtility::GenerateLabeledPointGroups(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    TArray<FGULGridComponent>& OutComponents,
+    const FBoundaryCells& BoundaryCells,
+    const FIntPoint& BoundsMin,
+    const FIntPoint& BoundsMax
     )
 {
-    FBox2D Bounds(ForceInitToZero);
-    Bounds += FVector2D(BoundsMin.X, BoundsMin.Y);
-    Bounds += FVector2D(BoundsMax.X, BoundsMax.Y);
+    FGULGridComponentLabeler Labeler(BoundsMin, BoundsMax);
+    GULGridUtility::SetBoundaryCells(Labeler, BoundaryCells);
+    Labeler.Label();
 
-    BoundsMin.X = FMath::RoundToInt(Bounds.Min.X);
-    BoundsMin.Y = FMath::RoundToInt(Bounds.Min.Y);
+    const TArray<FGULGridComponent>& Components(Labeler.GetComponents());
 
-    BoundsMax.X = FMath::RoundToInt(Bounds.Max.X);
-    BoundsMax.Y = FMath::RoundToInt(Bounds.Max.Y);
+    TArray<int32> ComponentGroupIndices;
+    ComponentGroupIndices.Init(INDEX_NONE, Components.Num());
 
-    TArray<FIntPoint> TargetPoints = InTargetPoints.FilterByPredicate(
-    [BoundsMin, BoundsMax](const FIntPoint& TargetPoint)
-    {
-        return IsOnBounds(TargetPoint, BoundsMin, BoundsMax);
-    } );
+    const FIntPoint Offsets[4] = {
+        FIntPoint(-1,  0), // W
+        FIntPoint( 0, -1), // S
+        FIntPoint( 1,  0), // E
+        FIntPoint( 0,  1)  // N
+        };
 
-    if (TargetPoints.Num() < 1)
+    // Assign output groups in boundary neighbour visit order
+
+    int32 GroupIndex = OutPointGroups.Num();
+
+    GULGridUtility::ForEachBoundaryCell(BoundaryCells, [&](const FIntPoint& BoundaryPoint)
     {
-        return false;
-    }
+        for (int32 i=0; i<4; ++i)
+        {
+            const int32 ComponentIndex = Labeler.GetLabel(BoundaryPoint+Offsets[i]);
 
-    PointFillMulti(
-        OutPoints,
-        BoundsMin,
-        BoundsMax,
-        TargetPoints,
-        FilterCallback
-        );
-    
-    return true;
+            if (ComponentIndex != INDEX_NONE && ComponentGroupIndices[ComponentIndex] == INDEX_NONE)
+            {
+                ComponentGroupIndices[ComponentIndex] = GroupIndex++;
+                OutComponents.Emplace(Components[ComponentIndex]);
+            }
+        }
+    } );
+
+    OutPointGroups.SetNum(GroupIndex);
+
+    Labeler.GenerateComponentPoints(OutPointGroups, ComponentGroupIndices);
 }
 
-void UGULGridUtility::VisitPointsByPredicate(
-    const TArray<FIntPoint>& InTargetPoints,
-    FIntPoint BoundsMin,
-    FIntPoint BoundsMax,
-    TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+void UGULGridUtility::FilterBoundaryPointsWithinBounds(
+    TArray<FIntPoint>& OutBoundaryPoints,
+    FIntPoint& BoundsMin,
+    FIntPoint& BoundsMax,
+    const TArray<FIntPoint>& BoundaryPoints
     )
 {
     FBox2D Bounds(ForceInitToZero);
@@ -460,253 +655,1440 @@ void UGULGridUtility::VisitPointsByPredicate(
     BoundsMax.X = FMath::RoundToInt(Bounds.Max.X);
     BoundsMax.Y = FMath::RoundToInt(Bounds.Max.Y);
 
-    TArray<FIntPoint> TargetPoints = InTargetPoints.FilterByPredicate(
-    [BoundsMin, BoundsMax](const FIntPoint& TargetPoint)
+    OutBoundaryPoints.Reset(BoundaryPoints.Num());
+
+    for (const FIntPoint& Point : BoundaryPoints)
     {
-        return IsOnBounds(TargetPoint, BoundsMin, BoundsMax);
-    } );
+        if (IsOnBounds(Point, BoundsMin, BoundsMax))
+        {
+            OutBoundaryPoints.Emplace(Point);
+        }
+    }
+}
 
-    if (TargetPoints.Num() < 1)
+void UGULGridUtility::VisitPointsParallel(
+    const FIntPoint& BoundsMin,
+    const FIntPoint& BoundsMax,
+    const TArray<FIntPoint>& TargetPoints,
+    TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+    )
+{
+    const int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
+    const int32 CellCount = Size * ((BoundsMax.Y-BoundsMin.Y)+1);
+
+    check(Size > 0);
+
+    // Cells are claimed by the first thread that offers them on a level,
+    // claims of rejected cells are released at the end of each level
+
+    FGULGridAtomicBitArray ClaimStates;
+    ClaimStates.Init(CellCount);
+
+    // Accept all visited points without visit callback
+
+    if (! VisitCallback)
     {
-        return;
+        VisitCallback = [](int32, FIntPoint, int32) { return true; };
     }
 
-    VisitPoints(
-        BoundsMin,
-        BoundsMax,
-        TargetPoints,
-        VisitCallback
+    TArray<FIntPoint> Frontier;
+
+    // Visit target points
+    for (const FIntPoint& TargetPoint : TargetPoints)
+    {
+        if (! IsOnBounds(TargetPoint, BoundsMin, BoundsMax))
+        {
+            continue;
+        }
+
+        int32 TargetIndex = GetGridIndex(TargetPoint, BoundsMin, Size);
+
+        if (ClaimStates.Get(TargetIndex))
+        {
+            continue;
+        }
+
+        if (VisitCallback(TargetIndex, TargetPoint, 0))
+        {
+            ClaimStates.TrySet(TargetIndex);
+            Frontier.Emplace(TargetPoint);
+        }
+    }
+
+    const FIntPoint Offsets[4] = {
+        FIntPoint(-1,  0), // W
+        FIntPoint( 0, -1), // S
+        FIntPoint( 1,  0), // E
+        FIntPoint( 0,  1)  // N
+        };
+
+    struct FBatchResult
+    {
+        TArray<FIntPoint> VisitedPoints;
+        TArray<int32> RejectedIndices;
+    };
+
+    // Batch results are kept across levels to reuse their allocations
+
+    TArray<FBatchResult> BatchResults;
+    int32 Iteration = 1;
+
+    while (Frontier.Num() > 0)
+    {
+        const int32 FrontierCount = Frontier.Num();
+        const int32 BatchSize = GUL_GRID_VISIT_PARALLEL_BATCH_SIZE;
+        const int32 BatchCount = (FrontierCount+BatchSize-1) / BatchSize;
+
+        if (BatchResults.Num() < BatchCount)
+        {
+            BatchResults.SetNum(BatchCount);
+        }
+
+        // Expand frontier batches into per-batch next frontiers
+        ParallelFor(BatchCount, [&](int32 BatchIndex)
+        {
+            const int32 i0 = BatchIndex*BatchSize;
+            const int32 i1 = FMath::Min(i0+BatchSize, FrontierCount);
+
+            FBatchResult& BatchResult(BatchResults[BatchIndex]);
+            BatchResult.VisitedPoints.Reset();
+            BatchResult.RejectedIndices.Reset();
+
+            for (int32 i=i0; i<i1; ++i)
+            {
+                const FIntPoint& VisitPoint(Frontier[i]);
+
+                for (int32 oi=0; oi<4; ++oi)
+                {
+                    FIntPoint NeighbourPoint(VisitPoint+Offsets[oi]);
+
+                    // Skip out-of-bounds points
+                    if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax))
+                    {
+                        continue;
+                    }
+
+                    int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
+
+                    // Skip visited or already offered points
+                    if (! ClaimStates.TrySet(NeighbourIndex))
+                    {
+                        continue;
+                    }
+
+                    if (VisitCallback(NeighbourIndex, NeighbourPoint, Iteration))
+                    {
+                        BatchResult.VisitedPoints.Emplace(NeighbourPoint);
+                    }
+                    else
+                    {
+                        BatchResult.RejectedIndices.Emplace(NeighbourIndex);
+                    }
+                }
+            }
+        } );
+
+        // Merge batch frontiers in batch order and release rejected cells
+
+        Frontier.Reset();
+
+        for (int32 BatchIndex=0; BatchIndex<BatchCount; ++BatchIndex)
+        {
+            const FBatchResult& BatchResult(BatchResults[BatchIndex]);
+
+            Frontier.Append(BatchResult.VisitedPoints);
+
+            for (int32 RejectedIndex : BatchResult.RejectedIndices)
+            {
+                ClaimStates.Clear(RejectedIndex);
+            }
+        }
+
+        ++Iteration;
+    }
+}
+
+bool UGULGridUtility::GridFillByPoint(
+    TArray<FIntPoint>& OutPoints,
+    const TArray<FIntPoint>& BoundaryPoints,
+    const FIntPoint& FillTargetPoint,
+    EGULGridFillMode FillMode
+    )
+{
+    FGULGridScratch Scratch;
+
+    return GridFillByPoint(
+        OutPoints,
+        Scratch,
+        BoundaryPoints,
+        FillTargetPoint,
+        FillMode
         );
 }
 
-bool UGULGridUtility::GenerateGridAndEdgeGroupsIntersections(
-    TMap<int32, FGULVector2DGroup>& IntersectionMap,
-    TArray<FVector2D>& IntersectEdges,
-    const TArray<FGULVector2DGroup>& InEdgeGroups,
-    const FIntPoint& GridBoundsMin,
-    const FIntPoint& GridBoundsMax,
-    const FIntPoint& GridId,
-    int32 GridIndex,
-    float IntersectRadius
+bool UGULGridUtility::GridFillByPoint(
+    TArray<FIntPoint>& OutPoints,
+    FGULGridScratch& Scratch,
+    const TArray<FIntPoint>& BoundaryPoints,
+    const FIntPoint& FillTargetPoint,
+    EGULGridFillMode FillMode
     )
 {
-    check((GridBoundsMax-GridBoundsMin).SizeSquared() > KINDA_SMALL_NUMBER);
+    if (BoundaryPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, EMPTY BOUNDARY POINTS"));
+        return false;
+    }
 
-    float Radius = FMath::Abs(IntersectRadius);
-    float RadiusSq = Radius*Radius;
+    FIntPoint BoundsMin;
+    FIntPoint BoundsMax;
+    int32 Size;
 
-    FBox2D Bounds(ForceInitToZero);
-    Bounds += FVector2D(GridBoundsMin);
-    Bounds += FVector2D(GridBoundsMax);
-    Bounds = Bounds.ExpandBy(Radius);
+    GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
 
-    FVector2D SegA[4] = {
-        FVector2D(Bounds.Min.X, Bounds.Min.Y),
-        FVector2D(Bounds.Max.X, Bounds.Min.Y),
-        FVector2D(Bounds.Max.X, Bounds.Max.Y),
-        FVector2D(Bounds.Min.X, Bounds.Max.Y)
-        };
+    if (! IsOnBounds(FillTargetPoint, BoundsMin, BoundsMax))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, OUT-OF-BOUND FILL TARGET POINT"));
+        return false;
+    }
 
-    int32 LastIntersectEdgeCount = IntersectEdges.Num();
+    FGULGridCellStates& CellStates(Scratch.CellStates);
+    CellStates.Init(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(BoundaryPoints);
 
-    for (const FGULVector2DGroup& EdgeGroup : InEdgeGroups)
+    if (CellStates.IsBoundary(CellStates.GetIndex(FillTargetPoint)))
     {
-        const TArray<FVector2D>& Points(EdgeGroup.Points);
-        const int32 PointCount = Points.Num();
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillByPoint() ABORTED, FILL TARGET POINT IS A BOUNDARY POINT"));
+        return false;
+    }
 
-        for (int32 pi=0; pi<(PointCount-1); ++pi)
-        {
-            int32 i0 = pi;
-            int32 i1 = pi+1;
+    PointFillByMode(
+        OutPoints,
+        CellStates,
+        Scratch,
+        FillTargetPoint,
+        FillMode
+        );
+    
+    return true;
+}
+
+bool UGULGridUtility::GridFillSparseByPoint(
+    TArray<FIntPoint>& OutPoints,
+    const FGULSparseGrid& BoundaryGrid,
+    const FIntPoint& FillTargetPoint,
+    EGULGridFillMode FillMode
+    )
+{
+    FGULGridScratch Scratch;
+    FGULGridSparseCellStates CellStates;
+
+    if (! CellStates.Init(BoundaryGrid))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSparseByPoint() ABORTED, EMPTY BOUNDARY GRID"));
+        return false;
+    }
+
+    if (! CellStates.IsOnBounds(FillTargetPoint))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSparseByPoint() ABORTED, OUT-OF-BOUND FILL TARGET POINT"));
+        return false;
+    }
+
+    if (CellStates.IsBoundary(CellStates.GetIndex(FillTargetPoint)))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSparseByPoint() ABORTED, FILL TARGET POINT IS A BOUNDARY POINT"));
+        return false;
+    }
+
+    PointFillByMode(
+        OutPoints,
+        CellStates,
+        Scratch,
+        FillTargetPoint,
+        FillMode
+        );
+
+    return true;
+}
+
+bool UGULGridUtility::GridFillSpansByPoint(
+    TArray<FGULGridSpan>& OutSpans,
+    const TArray<FIntPoint>& BoundaryPoints,
+    const FIntPoint& FillTargetPoint
+    )
+{
+    FGULGridScratch Scratch;
+
+    return GridFillSpansByPoint(
+        OutSpans,
+        Scratch,
+        BoundaryPoints,
+        FillTargetPoint
+        );
+}
+
+bool UGULGridUtility::GridFillSpansByPoint(
+    TArray<FGULGridSpan>& OutSpans,
+    FGULGridScratch& Scratch,
+    const TArray<FIntPoint>& BoundaryPoints,
+    const FIntPoint& FillTargetPoint
+    )
+{
+    if (BoundaryPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSpansByPoint() ABORTED, EMPTY BOUNDARY POINTS"));
+        return false;
+    }
+
+    FIntPoint BoundsMin;
+    FIntPoint BoundsMax;
+    int32 Size;
+
+    GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
+
+    if (! IsOnBounds(FillTargetPoint, BoundsMin, BoundsMax))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSpansByPoint() ABORTED, OUT-OF-BOUND FILL TARGET POINT"));
+        return false;
+    }
+
+    FGULGridCellStates& CellStates(Scratch.CellStates);
+    CellStates.Init(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(BoundaryPoints);
+
+    if (CellStates.IsBoundary(CellStates.GetIndex(FillTargetPoint)))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GridFillSpansByPoint() ABORTED, FILL TARGET POINT IS A BOUNDARY POINT"));
+        return false;
+    }
+
+    SpanFill(
+        OutSpans,
+        CellStates,
+        Scratch.SeedStack,
+        FillTargetPoint
+        );
+    
+    return true;
+}
+
+bool UGULGridUtility::GridFillSpansByPoint(
+    FGULGridSpanSet& OutSpanSet,
+    const TArray<FIntPoint>& BoundaryPoints,
+    const FIntPoint& FillTargetPoint
+    )
+{
+    FGULGridScratch Scratch;
+
+    OutSpanSet.Reset();
+
+    if (! GridFillSpansByPoint(Scratch.Spans, Scratch, BoundaryPoints, FillTargetPoint))
+    {
+        return false;
+    }
+
+    OutSpanSet.SetSpans(MoveTemp(Scratch.Spans));
 
-            const FVector2D& SegB0(Points[i0]);
-            const FVector2D& SegB1(Points[i1]);
+    return true;
+}
 
-            const bool bValidSegB = (SegB1-SegB0).SizeSquared() > KINDA_SMALL_NUMBER;
+bool UGULGridUtility::GridFillBoundsByPoints(
+    TArray<FIntPoint>& OutPoints,
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    TFunction<bool(int32, FIntPoint)> FilterCallback
+    )
+{
+    if (FilterCallback)
+    {
+        return GridFillBoundsByPoints(
+            OutPoints,
+            InTargetPoints,
+            BoundsMin,
+            BoundsMax,
+            [&FilterCallback](int32 Index, const FIntPoint& Point)
+            {
+                return FilterCallback(Index, Point);
+            } );
+    }
+    else
+    {
+        return GridFillBoundsByPoints(
+            OutPoints,
+            InTargetPoints,
+            BoundsMin,
+            BoundsMax,
+            [](int32, const FIntPoint&) { return true; }
+            );
+    }
+}
+
+void UGULGridUtility::VisitPointsByPredicate(
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+    )
+{
+    if (VisitCallback)
+    {
+        VisitPointsByPredicate(
+            InTargetPoints,
+            BoundsMin,
+            BoundsMax,
+            [&VisitCallback](int32 Index, const FIntPoint& Point, int32 Iteration)
+            {
+                return VisitCallback(Index, Point, Iteration);
+            } );
+    }
+    else
+    {
+        VisitPointsByPredicate(
+            InTargetPoints,
+            BoundsMin,
+            BoundsMax,
+            [](int32, const FIntPoint&, int32) { return true; }
+            );
+    }
+}
+
+void UGULGridUtility::VisitPointsByPredicateParallel(
+    const TArray<FIntPoint>& InTargetPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    TFunction<bool(int32, FIntPoint, int32)> VisitCallback
+    )
+{
+    TArray<FIntPoint> TargetPoints;
+    FilterBoundaryPointsWithinBounds(TargetPoints, BoundsMin, BoundsMax, InTargetPoints);
+
+    if (TargetPoints.Num() < 1)
+    {
+        return;
+    }
+
+    VisitPointsParallel(
+        BoundsMin,
+        BoundsMax,
+        TargetPoints,
+        VisitCallback
+        );
+}
+
+bool UGULGridUtility::GenerateDistanceField(
+    TArray<float>& OutDistances,
+    const TArray<FIntPoint>& SeedPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    EGULGridDistanceMetric Metric
+    )
+{
+    TArray<FIntPoint> ValidSeedPoints;
+    FilterBoundaryPointsWithinBounds(ValidSeedPoints, BoundsMin, BoundsMax, SeedPoints);
+
+    if (ValidSeedPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateDistanceField() ABORTED, NO SEED POINT WITHIN BOUNDS"));
+        return false;
+    }
+
+    FGULGridDistanceTransform DistanceTransform(BoundsMin, BoundsMax);
+    DistanceTransform.Generate(ValidSeedPoints, Metric);
+    DistanceTransform.MoveDistances(OutDistances);
+
+    return true;
+}
+
+bool UGULGridUtility::GenerateDistanceFieldUInt16(
+    TArray<uint16>& OutDistances,
+    const TArray<FIntPoint>& SeedPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    EGULGridDistanceMetric Metric,
+    float DistanceScale
+    )
+{
+    TArray<FIntPoint> ValidSeedPoints;
+    FilterBoundaryPointsWithinBounds(ValidSeedPoints, BoundsMin, BoundsMax, SeedPoints);
+
+    if (ValidSeedPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateDistanceFieldUInt16() ABORTED, NO SEED POINT WITHIN BOUNDS"));
+        return false;
+    }
+
+    FGULGridDistanceTransform DistanceTransform(BoundsMin, BoundsMax);
+    DistanceTransform.Generate(ValidSeedPoints, Metric);
+    DistanceTransform.GetDistancesUInt16(OutDistances, DistanceScale);
+
+    return true;
+}
+
+void UGULGridUtility::AppendSegmentsOnBounds(
+    TArray<FVector2D>& OutSegmentPoints,
+    TArray<bool>& SegmentResults,
+    TArrayView<const FVector2D> InPoints0,
+    TArrayView<const FVector2D> InPoints1,
+    const FBox2D& Bounds,
+    float RadiusSq
+    )
+{
+    UGULGeometryUtility::SegmentsIntersectBounds(SegmentResults, InPoints0, InPoints1, Bounds);
+
+    for (int32 i=0; i<InPoints0.Num(); ++i)
+    {
+        const FVector2D& SegB0(InPoints0[i]);
+        const FVector2D& SegB1(InPoints1[i]);
+
+        bool bHasIntersection = SegmentResults[i];
+
+        // Edge segment have nearly zero length,
+        // also accept points within radius of the bounds
+        if (! bHasIntersection && (SegB1-SegB0).SizeSquared() <= KINDA_SMALL_NUMBER)
+        {
+            FVector2D ClosestP = Bounds.GetClosestPointTo(SegB0);
+            bHasIntersection = (ClosestP-SegB0).SizeSquared() <= RadiusSq;
+        }
+
+        if (bHasIntersection)
+        {
+            OutSegmentPoints.Emplace(SegB0);
+            OutSegmentPoints.Emplace(SegB1);
+        }
+    }
+}
+
+bool UGULGridUtility::GenerateGridAndEdgeGroupsIntersections(
+    TMap<int32, FGULVector2DGroup>& IntersectionMap,
+    TArray<FVector2D>& IntersectEdges,
+    const TArray<FGULVector2DGroup>& InEdgeGroups,
+    const FIntPoint& GridBoundsMin,
+    const FIntPoint& GridBoundsMax,
+    const FIntPoint& GridId,
+    int32 GridIndex,
+    float IntersectRadius
+    )
+{
+    check((GridBoundsMax-GridBoundsMin).SizeSquared() > KINDA_SMALL_NUMBER);
+
+    float Radius = FMath::Abs(IntersectRadius);
+    float RadiusSq = Radius*Radius;
+
+    FBox2D Bounds(ForceInitToZero);
+    Bounds += FVector2D(GridBoundsMin);
+    Bounds += FVector2D(GridBoundsMax);
+    Bounds = Bounds.ExpandBy(Radius);
+
+    int32 LastIntersectEdgeCount = IntersectEdges.Num();
+
+    TArray<bool> SegmentResults;
+
+    for (const FGULVector2DGroup& EdgeGroup : InEdgeGroups)
+    {
+        const TArray<FVector2D>& Points(EdgeGroup.Points);
+        const int32 SegmentCount = Points.Num()-1;
+
+        if (SegmentCount < 1)
+        {
+            continue;
+        }
+
+        AppendSegmentsOnBounds(
+            IntersectEdges,
+            SegmentResults,
+            TArrayView<const FVector2D>(Points.GetData(), SegmentCount),
+            TArrayView<const FVector2D>(Points.GetData()+1, SegmentCount),
+            Bounds,
+            RadiusSq
+            );
+    }
+
+    bool bHasIntersection = IntersectEdges.Num() > LastIntersectEdgeCount;
+
+    return bHasIntersection;
+}
+
+bool UGULGridUtility::GenerateGridsAndEdgeGroupsIntersections(
+    TMap<int32, FGULVector2DGroup>& OutIntersectionMap,
+    const TArray<FGULVector2DGroup>& InEdgeGroups,
+    const TArray<FIntPoint>& InGridIds,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    float IntersectRadius
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateGridsAndEdgeGroupsIntersections() ABORTED, INVALID GRID SIZE"));
+        return false;
+    }
+
+    const float Radius = FMath::Abs(IntersectRadius);
+    const float RadiusSq = Radius*Radius;
+    const FVector2D GridSize(InGridSizeX, InGridSizeY);
+
+    // Gather edge segments end points
+
+    TArray<FVector2D> SegmentPoints0;
+    TArray<FVector2D> SegmentPoints1;
+
+    for (const FGULVector2DGroup& EdgeGroup : InEdgeGroups)
+    {
+        const TArray<FVector2D>& Points(EdgeGroup.Points);
+
+        for (int32 pi=0; pi<(Points.Num()-1); ++pi)
+        {
+            SegmentPoints0.Emplace(Points[pi  ]);
+            SegmentPoints1.Emplace(Points[pi+1]);
+        }
+    }
+
+    const int32 SegmentCount = SegmentPoints0.Num();
+    const int32 GridCount = InGridIds.Num();
+
+    if (SegmentCount < 1 || GridCount < 1)
+    {
+        return false;
+    }
+
+    // Bin segments by the grid cells they walk through
+
+    TArray<uint64> BinKeys;
+    TArray<int32> BinSegmentIndices;
+    TArray<FIntPoint> WalkIds;
+
+    BinKeys.Reserve(SegmentCount*2);
+    BinSegmentIndices.Reserve(SegmentCount*2);
+
+    for (int32 SegmentIndex=0; SegmentIndex<SegmentCount; ++SegmentIndex)
+    {
+        const FVector2D& P0(SegmentPoints0[SegmentIndex]);
+        const FVector2D& P1(SegmentPoints1[SegmentIndex]);
+
+        WalkIds.Reset();
+        WalkIds.Emplace(GetGridId(P0, InGridSizeX, InGridSizeY));
+
+        GridWalk(WalkIds, P0, P1, InGridSizeX, InGridSizeY);
+
+        for (const FIntPoint& WalkId : WalkIds)
+        {
+            BinKeys.Emplace(UGULMathLibrary::PackGridKey(WalkId));
+            BinSegmentIndices.Emplace(SegmentIndex);
+        }
+    }
+
+    TArray<int32> SortedIndices;
+    FGULSortUtility::RadixSortIndices(SortedIndices, TArrayView<const uint64>(BinKeys));
+
+    // Generate sorted unique bin keys and bin segment offsets, bin i
+    // segments are within [BinOffsets[i], BinOffsets[i+1]) and stay in
+    // input order
+
+    const int32 BinEntryCount = SortedIndices.Num();
+
+    TArray<int32> SortedSegmentIndices;
+    TArray<uint64> UniqueBinKeys;
+    TArray<int32> BinOffsets;
+
+    SortedSegmentIndices.SetNumUninitialized(BinEntryCount);
+
+    for (int32 i=0; i<BinEntryCount; ++i)
+    {
+        const uint64 BinKey = BinKeys[SortedIndices[i]];
+
+        SortedSegmentIndices[i] = BinSegmentIndices[SortedIndices[i]];
+
+        if (i == 0 || BinKey != UniqueBinKeys.Last())
+        {
+            UniqueBinKeys.Emplace(BinKey);
+            BinOffsets.Emplace(i);
+        }
+    }
+
+    BinOffsets.Emplace(BinEntryCount);
+
+    const int32 BinCount = UniqueBinKeys.Num();
+
+    // Query cells, neighbour bins are included to catch segments
+    // that only touch the radius expanded (closed) cell bounds.
+    // Zero length segments are tested against the expanded bounds
+    // with an additional radius, the ring covers both.
+
+    const int32 RingX = FMath::FloorToInt(2.f*Radius / InGridSizeX) + 1;
+    const int32 RingY = FMath::FloorToInt(2.f*Radius / InGridSizeY) + 1;
+
+    TArray< TArray<FVector2D> > GridIntersectEdges;
+    GridIntersectEdges.SetNum(GridCount);
+
+    const int32 BatchSize = GUL_GRID_INTERSECT_BATCH_SIZE;
+    const int32 BatchCount = (GridCount+BatchSize-1) / BatchSize;
+
+    // Query cells in batches, candidate buffers are reused within a batch
+
+    ParallelFor(BatchCount, [&](int32 BatchIndex)
+    {
+        const int32 GridStart = BatchIndex*BatchSize;
+        const int32 GridEnd = FMath::Min(GridStart+BatchSize, GridCount);
+
+        TArray<int32> CandidateIndices;
+        TArray<FVector2D> CandidatePoints0;
+        TArray<FVector2D> CandidatePoints1;
+        TArray<bool> SegmentResults;
+
+        for (int32 GridIndex=GridStart; GridIndex<GridEnd; ++GridIndex)
+        {
+            const FIntPoint& GridId(InGridIds[GridIndex]);
+
+            FBox2D Bounds(ForceInitToZero);
+            Bounds += FVector2D(GridId.X, GridId.Y) * GridSize;
+            Bounds += FVector2D(GridId.X+1, GridId.Y+1) * GridSize;
+            Bounds = Bounds.ExpandBy(Radius);
+
+            CandidateIndices.Reset();
+
+            // Bin keys are in row-major order, neighbour bins of each row
+            // are a contiguous sorted key range
+
+            for (int32 dy=-RingY; dy<=RingY; ++dy)
+            {
+                const uint64 RowKey0 = UGULMathLibrary::PackGridKey(GridId.X-RingX, GridId.Y+dy);
+                const uint64 RowKey1 = UGULMathLibrary::PackGridKey(GridId.X+RingX, GridId.Y+dy);
+
+                for (int32 BinIt=Algo::LowerBound(UniqueBinKeys, RowKey0);
+                     BinIt<BinCount && UniqueBinKeys[BinIt]<=RowKey1;
+                     ++BinIt)
+                {
+                    CandidateIndices.Append(
+                        SortedSegmentIndices.GetData()+BinOffsets[BinIt],
+                        BinOffsets[BinIt+1]-BinOffsets[BinIt]
+                        );
+                }
+            }
+
+            if (CandidateIndices.Num() < 1)
+            {
+                continue;
+            }
+
+            // Gather unique candidates in segment order
+
+            CandidateIndices.Sort();
+
+            CandidatePoints0.Reset();
+            CandidatePoints1.Reset();
+            int32 LastSegmentIndex = INDEX_NONE;
+
+            for (int32 SegmentIndex : CandidateIndices)
+            {
+                if (SegmentIndex != LastSegmentIndex)
+                {
+                    CandidatePoints0.Emplace(SegmentPoints0[SegmentIndex]);
+                    CandidatePoints1.Emplace(SegmentPoints1[SegmentIndex]);
+                    LastSegmentIndex = SegmentIndex;
+                }
+            }
+
+            AppendSegmentsOnBounds(
+                GridIntersectEdges[GridIndex],
+                SegmentResults,
+                CandidatePoints0,
+                CandidatePoints1,
+                Bounds,
+                RadiusSq
+                );
+        }
+    } );
+
+    // Gather cell intersections
+
+    for (int32 GridIndex=0; GridIndex<GridCount; ++GridIndex)
+    {
+        if (GridIntersectEdges[GridIndex].Num() > 0)
+        {
+            OutIntersectionMap.Emplace(GridIndex).Points = MoveTemp(GridIntersectEdges[GridIndex]);
+        }
+    }
+
+    return OutIntersectionMap.Num() > 0;
+}
+
+void UGULGridUtility::SortUniqueGridIds(TArray<FIntPoint>& InOutGridIds, EGULGridOrder Order)
+{
+    const int32 GridCount = InOutGridIds.Num();
+
+    if (GridCount < 2)
+    {
+        return;
+    }
+
+    TArray<uint64> GridKeys;
+    GridKeys.SetNumUninitialized(GridCount);
+
+    ParallelFor(GridCount, [&](int32 i)
+    {
+        GridKeys[i] = GetGridOrderKey(InOutGridIds[i], Order);
+    } );
+
+    FGULSortUtility::ParallelRadixSort(GridKeys);
+
+    InOutGridIds.Reset();
+
+    for (int32 i=0; i<GridCount; ++i)
+    {
+        if (i == 0 || GridKeys[i] != GridKeys[i-1])
+        {
+            InOutGridIds.Emplace(GetGridOrderPoint(GridKeys[i], Order));
+        }
+    }
+}
+
+void UGULGridUtility::GenerateGridsFromPolyPoints(
+    TArray<FIntPoint>& OutGridIds,
+    TArrayView<const FVector2D> InPolyPoints,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    bool bClosedPolygons,
+    float SparseLength
+    )
+{
+    TArray<FVector2D> SparsePoints;
+    UGULPolyUtilityLibrary::SubdividePolylinesWithinLength(
+        SparsePoints,
+        InPolyPoints,
+        SparseLength,
+        bClosedPolygons,
+        true
+        );
+
+    const int32 PointCount = SparsePoints.Num();
+    const int32 EdgeCount = PointCount-1;
+
+    // Grid walk poly line segments
+
+    TArray< TArray<FIntPoint> > GridIdGroups;
+    GridIdGroups.SetNum(EdgeCount);
+
+    // Generate grid data from line segments
+    ParallelFor(EdgeCount, [&](int32 EdgeIndex)
+    {
+        const FVector2D& P0(SparsePoints[EdgeIndex  ]);
+        const FVector2D& P1(SparsePoints[EdgeIndex+1]);
+
+        FIntPoint ID0(GetGridId(P0, InGridSizeX, InGridSizeY));
+        FIntPoint ID1(GetGridId(P1, InGridSizeX, InGridSizeY));
+
+        TArray<FIntPoint>& GridIdGroup(GridIdGroups[EdgeIndex]);
+
+        GridIdGroup.Emplace(ID0);
+
+        if (ID0 != ID1)
+        {
+            GridWalk(
+                GridIdGroup,
+                P0,
+                P1,
+                InGridSizeX,
+                InGridSizeY
+                );
+        }
+    } );
+
+    // Gather grid id sets union
+    for (int32 i=0; i<EdgeCount; ++i)
+    {
+        OutGridIds.Append(MoveTemp(GridIdGroups[i]));
+    }
+
+    // Generate grid data from last line segment (last to first points)
+    if (bClosedPolygons && PointCount > 2)
+    {
+        int32 i0 = PointCount-1;
+        int32 i1 = 0;
+
+        const FVector2D& P0(SparsePoints[i0]);
+        const FVector2D& P1(SparsePoints[i1]);
+
+        // Close poly if not already
+        if (! P0.Equals(P1))
+        {
+            FIntPoint ID0(GetGridId(P0, InGridSizeX, InGridSizeY));
+            FIntPoint ID1(GetGridId(P1, InGridSizeX, InGridSizeY));
+
+            OutGridIds.Emplace(ID0);
+
+            if (ID0 != ID1)
+            {
+                GridWalk(
+                    OutGridIds,
+                    P0,
+                    P1,
+                    InGridSizeX,
+                    InGridSizeY
+                    );
+            }
+        }
+    }
+}
+
+void UGULGridUtility::GenerateGridsFromPolyGroups(
+    TArray<FIntPoint>& OutGridIds,
+    const TArray<FGULVector2DGroup>& InPolys,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    bool bClosedPolygons,
+    int32 GridSizePerSegment,
+    EGULGridOrder Order
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateGridsFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    const int32 PolyCount = InPolys.Num();
+    const FVector2D GridSize(InGridSizeX, InGridSizeY);
+    const float SparseLength = (GridSize*FMath::Max(1,GridSizePerSegment)).Size();
+
+    if (PolyCount < 1)
+    {
+        return;
+    }
+
+    TArray<FIntPoint> GridIds;
+
+    for (int32 PolyIt=0; PolyIt<PolyCount; ++PolyIt)
+    {
+        const TArray<FVector2D>& PolyPoints(InPolys[PolyIt].Points);
+
+        if (PolyPoints.Num() < 2)
+        {
+            continue;
+        }
+
+        GenerateGridsFromPolyPoints(
+            GridIds,
+            PolyPoints,
+            InGridSizeX,
+            InGridSizeY,
+            bClosedPolygons,
+            SparseLength
+            );
+    }
+
+    // Assign sorted unique ids as output
+
+    SortUniqueGridIds(GridIds, Order);
+    OutGridIds.Append(MoveTemp(GridIds));
+}
+
+void UGULGridUtility::GenerateGridsFromPolyGroups(
+    TArray<FIntPoint>& OutGridIds,
+    const FGULPolySoup& InPolySoup,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    bool bClosedPolygons,
+    int32 GridSizePerSegment,
+    EGULGridOrder Order
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateGridsFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    const int32 PolyCount = InPolySoup.GetRingNum();
+    const FVector2D GridSize(InGridSizeX, InGridSizeY);
+    const float SparseLength = (GridSize*FMath::Max(1,GridSizePerSegment)).Size();
+
+    if (PolyCount < 1)
+    {
+        return;
+    }
+
+    TArray<FIntPoint> GridIds;
+
+    for (int32 PolyIt=0; PolyIt<PolyCount; ++PolyIt)
+    {
+        const TArrayView<const FVector2D> PolyPoints(InPolySoup.GetRing(PolyIt));
+
+        if (PolyPoints.Num() < 2)
+        {
+            continue;
+        }
+
+        GenerateGridsFromPolyPoints(
+            GridIds,
+            PolyPoints,
+            InGridSizeX,
+            InGridSizeY,
+            bClosedPolygons,
+            SparseLength
+            );
+    }
+
+    // Assign sorted unique ids as output
+
+    SortUniqueGridIds(GridIds, Order);
+    OutGridIds.Append(MoveTemp(GridIds));
+}
+
+void UGULGridUtility::GenerateGridsFromPolyGroups(
+    FGULSparseGrid& OutGrid,
+    const TArray<FGULVector2DGroup>& InPolys,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    bool bClosedPolygons,
+    int32 GridSizePerSegment
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateGridsFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    const FVector2D GridSize(InGridSizeX, InGridSizeY);
+    const float SparseLength = (GridSize*FMath::Max(1,GridSizePerSegment)).Size();
+
+    TArray<FIntPoint> GridIds;
+
+    for (const FGULVector2DGroup& Poly : InPolys)
+    {
+        if (Poly.Points.Num() < 2)
+        {
+            continue;
+        }
+
+        GridIds.Reset();
+
+        GenerateGridsFromPolyPoints(
+            GridIds,
+            Poly.Points,
+            InGridSizeX,
+            InGridSizeY,
+            bClosedPolygons,
+            SparseLength
+            );
+
+        // Sparse grid insertion handles duplicate ids
+        OutGrid.Append(GridIds);
+    }
+}
+
+void UGULGridUtility::GenerateCoveredGridsFromPolyGroups(
+    TArray<FIntPoint>& OutGridIds,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    TArray<FGULGridSpan> Spans;
+    GenerateCoveredSpansFromPolyGroups(Spans, InPolyGroups, InGridSizeX, InGridSizeY);
+    ConvertSpansToPoints(OutGridIds, Spans);
+}
+
+void UGULGridUtility::GenerateCoveredGridsFromIndexedPolyGroups(
+    TArray<FIntPoint>& OutGridIds,
+    const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    TArray<FGULGridSpan> Spans;
+    GenerateCoveredSpansFromIndexedPolyGroups(Spans, InIndexGroups, InPolyGroups, InGridSizeX, InGridSizeY);
+    ConvertSpansToPoints(OutGridIds, Spans);
+}
+
+void UGULGridUtility::GenerateCoveredSpansFromPolyGroups(
+    TArray<FGULGridSpan>& OutSpans,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    OutSpans.Reset();
+
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateCoveredSpansFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    FGULGridScanConverter ScanConverter(InGridSizeX, InGridSizeY);
+    ScanConverter.AddPolyGroups(InPolyGroups);
+    ScanConverter.GenerateSpans(OutSpans);
+}
+
+void UGULGridUtility::GenerateCoveredSpansFromPolyGroups(
+    FGULGridSpanSet& OutSpanSet,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    OutSpanSet.Reset();
+
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateCoveredSpansFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    FGULGridScanConverter ScanConverter(InGridSizeX, InGridSizeY);
+    ScanConverter.AddPolyGroups(InPolyGroups);
+    ScanConverter.GenerateSpans(OutSpanSet);
+}
+
+void UGULGridUtility::GenerateCoveredSpansFromIndexedPolyGroups(
+    TArray<FGULGridSpan>& OutSpans,
+    const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    OutSpans.Reset();
+
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateCoveredSpansFromIndexedPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    FGULGridScanConverter ScanConverter(InGridSizeX, InGridSizeY);
+    ScanConverter.AddIndexedPolyGroups(InIndexGroups, InPolyGroups);
+    ScanConverter.GenerateSpans(OutSpans);
+}
+
+void UGULGridUtility::GenerateCoveredSpansFromIndexedPolyGroups(
+    FGULGridSpanSet& OutSpanSet,
+    const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY
+    )
+{
+    OutSpanSet.Reset();
+
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateCoveredSpansFromIndexedPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return;
+    }
+
+    FGULGridScanConverter ScanConverter(InGridSizeX, InGridSizeY);
+    ScanConverter.AddIndexedPolyGroups(InIndexGroups, InPolyGroups);
+    ScanConverter.GenerateSpans(OutSpanSet);
+}
+
+bool UGULGridUtility::GenerateSignedDistanceFieldFromPolyGroups(
+    TArray<float>& OutDistances,
+    FIntPoint& OutBoundsMin,
+    FIntPoint& OutBoundsMax,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    float BandWidth
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateSignedDistanceFieldFromPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return false;
+    }
+    else
+    if (BandWidth <= 0.f)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateSignedDistanceFieldFromPolyGroups() ABORTED, INVALID BAND WIDTH"));
+        return false;
+    }
+
+    FGULGridSDFRasterizer Rasterizer(InGridSizeX, InGridSizeY);
+    Rasterizer.AddPolyGroups(InPolyGroups);
+
+    return Rasterizer.Generate(OutDistances, OutBoundsMin, OutBoundsMax, BandWidth);
+}
+
+bool UGULGridUtility::GenerateSignedDistanceFieldFromIndexedPolyGroups(
+    TArray<float>& OutDistances,
+    FIntPoint& OutBoundsMin,
+    FIntPoint& OutBoundsMax,
+    const TArray<FGULIndexedPolyGroup>& InIndexGroups,
+    const TArray<FGULVector2DGroup>& InPolyGroups,
+    int32 InGridSizeX,
+    int32 InGridSizeY,
+    float BandWidth
+    )
+{
+    if (InGridSizeX < 1 || InGridSizeY < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateSignedDistanceFieldFromIndexedPolyGroups() ABORTED, INVALID GRID SIZE"));
+        return false;
+    }
+    else
+    if (BandWidth <= 0.f)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateSignedDistanceFieldFromIndexedPolyGroups() ABORTED, INVALID BAND WIDTH"));
+        return false;
+    }
+
+    FGULGridSDFRasterizer Rasterizer(InGridSizeX, InGridSizeY);
+    Rasterizer.AddIndexedPolyGroups(InIndexGroups, InPolyGroups);
+
+    return Rasterizer.Generate(OutDistances, OutBoundsMin, OutBoundsMax, BandWidth);
+}
+
+bool UGULGridUtility::GenerateIsolatedPointGroups(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    const TArray<FIntPoint>& BoundaryPoints,
+    EGULGridFillMode FillMode
+    )
+{
+    if (BoundaryPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedPointGroups() ABORTED, EMPTY BOUNDARY POINTS"));
+        return false;
+    }
+
+    FIntPoint BoundsMin;
+    FIntPoint BoundsMax;
+    int32 Size;
+
+    GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
+
+    if (FillMode == EGULGridFillMode::Labeling)
+    {
+        TArray<FGULGridComponent> Components;
+        GenerateLabeledPointGroups(OutPointGroups, Components, BoundaryPoints, BoundsMin, BoundsMax);
+        return true;
+    }
+
+    FGULGridCellStates CellStates(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(BoundaryPoints);
+
+    FGULGridScratch Scratch;
+
+    VisitIsolatedFillTargets(CellStates, BoundaryPoints,
+        [&](const FIntPoint& FillTargetPoint)
+        {
+            TArray<FIntPoint> IsolatedPoints;
+
+            PointFillByMode(
+                IsolatedPoints,
+                CellStates,
+                Scratch,
+                FillTargetPoint,
+                FillMode
+                );
+
+            if (IsolatedPoints.Num() > 0)
+            {
+                OutPointGroups.AddDefaulted();
+                OutPointGroups.Last().Points = MoveTemp(IsolatedPoints);
+            }
+        } );
+    
+    return true;
+}
+
+bool UGULGridUtility::GenerateIsolatedPointGroupsWithinBounds(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    const TArray<FIntPoint>& BoundaryPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax,
+    EGULGridFillMode FillMode
+    )
+{
+    TArray<FIntPoint> ValidBoundaryPoints;
+    FilterBoundaryPointsWithinBounds(ValidBoundaryPoints, BoundsMin, BoundsMax, BoundaryPoints);
+
+    if (ValidBoundaryPoints.Num() < 1)
+    {
+        OutPointGroups.AddDefaulted();
+        TArray<FIntPoint>& OutPoints(OutPointGroups.Last().Points);
+
+        for (int32 y=BoundsMin.Y; y<=BoundsMax.Y; ++y)
+        for (int32 x=BoundsMin.X; x<=BoundsMax.X; ++x)
+        {
+            OutPoints.Emplace(x, y);
+        }
 
-            bool bHasIntersection = false;
+        return true;
+    }
 
-            // Edge segments have non-zero length
-            if (bValidSegB)
-            {
-                FVector2D ClosestP0;
-                FVector2D ClosestP1;
+    if (FillMode == EGULGridFillMode::Labeling)
+    {
+        TArray<FGULGridComponent> Components;
+        GenerateLabeledPointGroups(OutPointGroups, Components, ValidBoundaryPoints, BoundsMin, BoundsMax);
+        return true;
+    }
 
-                for (int32 i=0; i<4; ++i)
-                {
-                    bHasIntersection = UGULGeometryUtility::SegmentIntersection2D(
-                        SegA[i      ],
-                        SegA[(i+1)%4],
-                        SegB0,
-                        SegB1
-                        );
+    FGULGridCellStates CellStates(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(ValidBoundaryPoints);
 
-                    if (bHasIntersection)
-                    {
-                        break;
-                    }
-                }
+    FGULGridScratch Scratch;
 
-                // No intersection found, check whether
-                // either of the points is inside grid bounds
-                if (! bHasIntersection &&
-                    (Bounds.IsInside(SegB0) || Bounds.IsInside(SegB1)))
-                {
-                    bHasIntersection = true;
-                }
-            }
-            // Edge segment have nearly zero length
-            else
-            {
-                FVector2D ClosestP = Bounds.GetClosestPointTo(SegB0);
-                float DistSq = (ClosestP-SegB0).SizeSquared();
+    VisitIsolatedFillTargets(CellStates, ValidBoundaryPoints,
+        [&](const FIntPoint& FillTargetPoint)
+        {
+            TArray<FIntPoint> IsolatedPoints;
 
-                if (DistSq <= RadiusSq || Bounds.IsInside(SegB0))
-                {
-                    bHasIntersection = true;
-                }
-            }
+            PointFillByMode(
+                IsolatedPoints,
+                CellStates,
+                Scratch,
+                FillTargetPoint,
+                FillMode
+                );
 
-            if (bHasIntersection)
+            if (IsolatedPoints.Num() > 0)
             {
-                IntersectEdges.Emplace(SegB0);
-                IntersectEdges.Emplace(SegB1);
+                OutPointGroups.AddDefaulted();
+                OutPointGroups.Last().Points = MoveTemp(IsolatedPoints);
             }
-        }
-    }
-
-    bool bHasIntersection = IntersectEdges.Num() > LastIntersectEdgeCount;
-
-    return bHasIntersection;
+        } );
+    
+    return true;
 }
 
-void UGULGridUtility::GenerateGridsFromPolyGroups(
-    TArray<FIntPoint>& OutGridIds,
-    const TArray<FGULVector2DGroup>& InPolys,
-    int32 InGridSizeX,
-    int32 InGridSizeY,
-    bool bClosedPolygons,
-    int32 GridSizePerSegment
+bool UGULGridUtility::GenerateIsolatedPointGroupsFromSparseGrid(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    const FGULSparseGrid& BoundaryGrid,
+    EGULGridFillMode FillMode
     )
 {
-    if (InGridSizeX < 1 || InGridSizeY < 1)
-    {
-        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateGridsFromPolyGroups() ABORTED, INVALID GRID SIZE"));
-        return;
-    }
-
-    const int32 PolyCount = InPolys.Num();
-    const FVector2D GridSize(InGridSizeX, InGridSizeY);
-    const float SparseLength = (GridSize*FMath::Max(1,GridSizePerSegment)).Size();
-
-    if (PolyCount < 1)
-    {
-        return;
-    }
-
-    TArray<FIntPoint> GridIds;
+    // Boundary cells in sparse grid iteration order define group order
 
-    for (int32 PolyIt=0; PolyIt<PolyCount; ++PolyIt)
+    if (FillMode == EGULGridFillMode::Labeling)
     {
-        const TArray<FVector2D>& PolyPoints(InPolys[PolyIt].Points);
+        FIntPoint BoundsMin;
+        FIntPoint BoundsMax;
 
-        if (PolyPoints.Num() < 2)
+        if (! BoundaryGrid.GetBounds(BoundsMin, BoundsMax))
         {
-            return;
+            UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedPointGroupsFromSparseGrid() ABORTED, EMPTY BOUNDARY GRID"));
+            return false;
         }
 
-        TArray<FVector2D> SparsePoints;
-        UGULPolyUtilityLibrary::SubdividePolylinesWithinLength(
-            SparsePoints,
-            PolyPoints,
-            SparseLength,
-            bClosedPolygons,
-            true
+        TArray<FGULGridComponent> Components;
+        GenerateLabeledPointGroups(
+            OutPointGroups,
+            Components,
+            BoundaryGrid,
+            BoundsMin,
+            BoundsMax
             );
+        return true;
+    }
 
-        const int32 PointCount = SparsePoints.Num();
-        const int32 EdgeCount = PointCount-1;
+    FGULGridSparseCellStates CellStates;
 
-        // Grid walk poly line segments
+    if (! CellStates.Init(BoundaryGrid))
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedPointGroupsFromSparseGrid() ABORTED, EMPTY BOUNDARY GRID"));
+        return false;
+    }
 
-        TArray< TArray<FIntPoint> > GridIdGroups;
-        GridIdGroups.SetNum(EdgeCount);
+    FGULGridScratch Scratch;
 
-        // Generate grid data from line segments
-        ParallelFor(EdgeCount, [&](int32 EdgeIndex)
+    VisitIsolatedFillTargets(CellStates, BoundaryGrid,
+        [&](const FIntPoint& FillTargetPoint)
         {
-            const FVector2D& P0(SparsePoints[EdgeIndex  ]);
-            const FVector2D& P1(SparsePoints[EdgeIndex+1]);
-
-            FIntPoint ID0(GetGridId(P0, InGridSizeX, InGridSizeY));
-            FIntPoint ID1(GetGridId(P1, InGridSizeX, InGridSizeY));
-
-            TArray<FIntPoint>& GridIdGroup(GridIdGroups[EdgeIndex]);
+            TArray<FIntPoint> IsolatedPoints;
 
-            GridIdGroup.Emplace(ID0);
+            PointFillByMode(
+                IsolatedPoints,
+                CellStates,
+                Scratch,
+                FillTargetPoint,
+                FillMode
+                );
 
-            if (ID0 != ID1)
+            if (IsolatedPoints.Num() > 0)
             {
-                GridWalk(
-                    GridIdGroup,
-                    P0,
-                    P1,
-                    InGridSizeX,
-                    InGridSizeY
-                    );
+                OutPointGroups.AddDefaulted();
+                OutPointGroups.Last().Points = MoveTemp(IsolatedPoints);
             }
         } );
 
-        // Gather grid id sets union
-        for (int32 i=0; i<EdgeCount; ++i)
-        {
-            GridIds.Append(MoveTemp(GridIdGroups[i]));
-        }
+    return true;
+}
 
-        // Generate grid data from last line segment (last to first points)
-        if (bClosedPolygons && PointCount > 2)
-        {
-            int32 i0 = PointCount-1;
-            int32 i1 = 0;
+bool UGULGridUtility::GenerateIsolatedComponents(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    TArray<FGULGridComponent>& OutComponents,
+    const TArray<FIntPoint>& BoundaryPoints
+    )
+{
+    OutPointGroups.Reset();
+    OutComponents.Reset();
 
-            const FVector2D& P0(SparsePoints[i0]);
-            const FVector2D& P1(SparsePoints[i1]);
+    if (BoundaryPoints.Num() < 1)
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedComponents() ABORTED, EMPTY BOUNDARY POINTS"));
+        return false;
+    }
 
-            // Close poly if not already
-            if (! P0.Equals(P1))
-            {
-                FIntPoint ID0(GetGridId(P0, InGridSizeX, InGridSizeY));
-                FIntPoint ID1(GetGridId(P1, InGridSizeX, InGridSizeY));
+    FIntPoint BoundsMin;
+    FIntPoint BoundsMax;
+    int32 Size;
 
-                GridIds.Emplace(ID0);
+    GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
+    GenerateLabeledPointGroups(OutPointGroups, OutComponents, BoundaryPoints, BoundsMin, BoundsMax);
 
-                if (ID0 != ID1)
-                {
-                    GridWalk(
-                        GridIds,
-                        P0,
-                        P1,
-                        InGridSizeX,
-                        InGridSizeY
-                        );
-                }
-            }
+    return true;
+}
+
+bool UGULGridUtility::GenerateIsolatedComponentsWithinBounds(
+    TArray<FGULIntPointGroup>& OutPointGroups,
+    TArray<FGULGridComponent>& OutComponents,
+    const TArray<FIntPoint>& BoundaryPoints,
+    FIntPoint BoundsMin,
+    FIntPoint BoundsMax
+    )
+{
+    OutPointGroups.Reset();
+    OutComponents.Reset();
+
+    TArray<FIntPoint> ValidBoundaryPoints;
+    FilterBoundaryPointsWithinBounds(ValidBoundaryPoints, BoundsMin, BoundsMax, BoundaryPoints);
+
+    if (ValidBoundaryPoints.Num() < 1)
+    {
+        OutPointGroups.AddDefaulted();
+        OutComponents.AddDefaulted();
+
+        TArray<FIntPoint>& OutPoints(OutPointGroups.Last().Points);
+        FGULGridComponent& OutComponent(OutComponents.Last());
+
+        for (int32 y=BoundsMin.Y; y<=BoundsMax.Y; ++y)
+        for (int32 x=BoundsMin.X; x<=BoundsMax.X; ++x)
+        {
+            OutPoints.Emplace(x, y);
+            OutComponent.Add(x, y);
         }
+
+        return true;
     }
 
-    // Assign unique ids as output
+    GenerateLabeledPointGroups(OutPointGroups, OutComponents, ValidBoundaryPoints, BoundsMin, BoundsMax);
 
-    OutGridIds.Append(TSet<FIntPoint>(MoveTemp(GridIds)).Array());
+    return true;
 }
 
-bool UGULGridUtility::GenerateIsolatedPointGroups(
-    TArray<FGULIntPointGroup>& OutPointGroups,
+bool UGULGridUtility::GenerateIsolatedSpanGroups(
+    TArray<FGULGridSpanGroup>& OutSpanGroups,
     const TArray<FIntPoint>& BoundaryPoints
     )
 {
     if (BoundaryPoints.Num() < 1)
     {
-        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedPointGroups() ABORTED, EMPTY BOUNDARY POINTS"));
+        UE_LOG(LogGUL,Warning, TEXT("UGULGridUtility::GenerateIsolatedSpanGroups() ABORTED, EMPTY BOUNDARY POINTS"));
         return false;
     }
 
@@ -716,144 +2098,110 @@ bool UGULGridUtility::GenerateIsolatedPointGroups(
 
     GenerateBoundaryData(BoundsMin, BoundsMax, Size, BoundaryPoints);
 
-    TSet<int32> BoundaryIndexSet;
-    GenerateIndexSet(BoundaryIndexSet, BoundaryPoints, BoundsMin, Size);
+    FGULGridCellStates CellStates(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(BoundaryPoints);
 
-    TSet<int32> VisitedIndexSet;
-
-    const FIntPoint Offsets[4] = {
-        FIntPoint(-1,  0), // W
-        FIntPoint( 0, -1), // S
-        FIntPoint( 1,  0), // E
-        FIntPoint( 0,  1)  // N
-        };
+    TArray<FIntPoint> SeedStack;
 
-    for (const FIntPoint& BoundaryPoint : BoundaryPoints)
-    {
-        for (int32 i=0; i<4; ++i)
+    VisitIsolatedFillTargets(CellStates, BoundaryPoints,
+        [&](const FIntPoint& FillTargetPoint)
         {
-            FIntPoint NeighbourPoint(BoundaryPoint+Offsets[i]);
-            int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
+            OutSpanGroups.AddDefaulted();
+            SpanFill(OutSpanGroups.Last().Spans, CellStates, SeedStack, FillTargetPoint);
+        } );
+    
+    return true;
+}
 
-            if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax) ||
-                BoundaryIndexSet.Contains(NeighbourIndex) ||
-                VisitedIndexSet.Contains(NeighbourIndex))
-            {
-                continue;
-            }
+bool UGULGridUtility::GenerateIsolatedSpanGroups(
+    TArray<FGULGridSpanSet>& OutSpanSets,
+    const TArray<FIntPoint>& BoundaryPoints
+    )
+{
+    TArray<FGULGridSpanGroup> SpanGroups;
 
-            TArray<FIntPoint> IsolatedPoints;
+    if (! GenerateIsolatedSpanGroups(SpanGroups, BoundaryPoints))
+    {
+        return false;
+    }
 
-            PointFill(
-                IsolatedPoints,
-                BoundaryIndexSet,
-                BoundsMin,
-                BoundsMax,
-                NeighbourPoint,
-                &VisitedIndexSet
-                );
+    OutSpanSets.Reserve(OutSpanSets.Num()+SpanGroups.Num());
 
-            if (IsolatedPoints.Num() > 0)
-            {
-                OutPointGroups.AddDefaulted();
-                OutPointGroups.Last().Points = MoveTemp(IsolatedPoints);
-            }
-        }
+    for (FGULGridSpanGroup& SpanGroup : SpanGroups)
+    {
+        OutSpanSets.AddDefaulted();
+        OutSpanSets.Last().SetSpans(MoveTemp(SpanGroup.Spans));
     }
-    
+
     return true;
 }
 
-bool UGULGridUtility::GenerateIsolatedPointGroupsWithinBounds(
-    TArray<FGULIntPointGroup>& OutPointGroups,
+bool UGULGridUtility::GenerateIsolatedSpanGroupsWithinBounds(
+    TArray<FGULGridSpanGroup>& OutSpanGroups,
     const TArray<FIntPoint>& BoundaryPoints,
     FIntPoint BoundsMin,
     FIntPoint BoundsMax
     )
 {
-    FBox2D Bounds(ForceInitToZero);
-    Bounds += FVector2D(BoundsMin.X, BoundsMin.Y);
-    Bounds += FVector2D(BoundsMax.X, BoundsMax.Y);
-
-    BoundsMin.X = FMath::RoundToInt(Bounds.Min.X);
-    BoundsMin.Y = FMath::RoundToInt(Bounds.Min.Y);
-
-    BoundsMax.X = FMath::RoundToInt(Bounds.Max.X);
-    BoundsMax.Y = FMath::RoundToInt(Bounds.Max.Y);
-
-    int32 Size = GetBoundsStride(BoundsMin, BoundsMax);
-
     TArray<FIntPoint> ValidBoundaryPoints;
-    ValidBoundaryPoints.Reserve(BoundaryPoints.Num());
-
-    for (const FIntPoint& Point : BoundaryPoints)
-    {
-        if (IsOnBounds(Point, BoundsMin, BoundsMax))
-        {
-            ValidBoundaryPoints.Emplace(Point);
-        }
-    }
+    FilterBoundaryPointsWithinBounds(ValidBoundaryPoints, BoundsMin, BoundsMax, BoundaryPoints);
 
     if (ValidBoundaryPoints.Num() < 1)
     {
-        OutPointGroups.AddDefaulted();
-        TArray<FIntPoint>& OutPoints(OutPointGroups.Last().Points);
+        OutSpanGroups.AddDefaulted();
+        TArray<FGULGridSpan>& OutSpans(OutSpanGroups.Last().Spans);
 
         for (int32 y=BoundsMin.Y; y<=BoundsMax.Y; ++y)
-        for (int32 x=BoundsMin.X; x<=BoundsMax.X; ++x)
         {
-            OutPoints.Emplace(x, y);
+            OutSpans.Emplace(y, BoundsMin.X, BoundsMax.X);
         }
 
         return true;
     }
 
-    TSet<int32> BoundaryIndexSet;
-    GenerateIndexSet(BoundaryIndexSet, ValidBoundaryPoints, BoundsMin, Size);
-
-    TSet<int32> VisitedIndexSet;
+    FGULGridCellStates CellStates(BoundsMin, BoundsMax);
+    CellStates.SetBoundaryPoints(ValidBoundaryPoints);
 
-    const FIntPoint Offsets[4] = {
-        FIntPoint(-1,  0), // W
-        FIntPoint( 0, -1), // S
-        FIntPoint( 1,  0), // E
-        FIntPoint( 0,  1)  // N
-        };
+    TArray<FIntPoint> SeedStack;
 
-    for (const FIntPoint& BoundaryPoint : ValidBoundaryPoints)
-    {
-        for (int32 i=0; i<4; ++i)
+    VisitIsolatedFillTargets(CellStates, ValidBoundaryPoints,
+        [&](const FIntPoint& FillTargetPoint)
         {
-            FIntPoint NeighbourPoint(BoundaryPoint+Offsets[i]);
-            int32 NeighbourIndex = GetGridIndex(NeighbourPoint, BoundsMin, Size);
+            OutSpanGroups.AddDefaulted();
+            SpanFill(OutSpanGroups.Last().Spans, CellStates, SeedStack, FillTargetPoint);
+        } );
+    
+    return true;
+}
 
-            if (! IsOnBounds(NeighbourPoint, BoundsMin, BoundsMax) ||
-                BoundaryIndexSet.Contains(NeighbourIndex) ||
-                VisitedIndexSet.Contains(NeighbourIndex))
-            {
-                continue;
-            }
+void UGULGridUtility::GenerateIsolatedGroupReferencePoints(
+    TArray<FVector2D>& OutReferencePoints,
+    const TArray<FGULIntPointGroup>& InPointGroups,
+    int32 GridSize
+    )
+{
+    const float GridSizeF = static_cast<float>(GridSize);
+    const FVector2D GridCenterOffset(GridSizeF*.5f, GridSizeF*.5f);
 
-            TArray<FIntPoint> IsolatedPoints;
+    OutReferencePoints.SetNumUninitialized(InPointGroups.Num());
 
-            PointFill(
-                IsolatedPoints,
-                BoundaryIndexSet,
-                BoundsMin,
-                BoundsMax,
-                NeighbourPoint,
-                &VisitedIndexSet
-                );
+    for (int32 i=0; i<InPointGroups.Num(); ++i)
+    {
+        const TArray<FIntPoint>& Points(InPointGroups[i].Points);
 
-            if (IsolatedPoints.Num() > 0)
-            {
-                OutPointGroups.AddDefaulted();
-                OutPointGroups.Last().Points = MoveTemp(IsolatedPoints);
-            }
+        // Empty point group, reference point result is irrelevant
+        if (Points.Num() < 1)
+        {
+            OutReferencePoints[i] = FVector2D::ZeroVector;
+            continue;
         }
+
+        FVector2D ReferencePoint;
+        ReferencePoint.X = Points[0].X*GridSize;
+        ReferencePoint.Y = Points[0].Y*GridSize;
+
+        OutReferencePoints[i] = ReferencePoint+GridCenterOffset;
     }
-    
-    return true;
 }
 
 void UGULGridUtility::GenerateIsolatedGridsOnPoly(
@@ -886,29 +2234,27 @@ void UGULGridUtility::GenerateIsolatedGridsOnPoly(
             );
     }
 
-    for (FGULIntPointGroup& PointGroup : IsolatedPointGroups)
+    TArray<FVector2D> ReferencePoints;
+    GenerateIsolatedGroupReferencePoints(ReferencePoints, IsolatedPointGroups, GridSize);
+
+    // Classify isolated point groups against prepared polys
+
+    TArray<FGULPreparedPoly> PreparedPolys;
+    PreparedPolys.Reserve(InPolyGroups.Num());
+
+    for (const FGULVector2DGroup& PolyGroup : InPolyGroups)
     {
-        if (PointGroup.Points.Num() < 1)
-        {
-            continue;
-        }
+        PreparedPolys.Emplace(PolyGroup.Points);
+    }
 
-        FVector2D ReferencePoint;
-        ReferencePoint.X = PointGroup.Points[0].X*GridSize;
-        ReferencePoint.Y = PointGroup.Points[0].Y*GridSize;
-        ReferencePoint.X += static_cast<float>(GridSize) * .5f;
-        ReferencePoint.Y += static_cast<float>(GridSize) * .5f;
+    TBitArray<> ReferencePointResults;
+    FGULPreparedPoly::ClassifyPoints(ReferencePoints, ReferencePointResults, PreparedPolys);
 
-        for (const FGULVector2DGroup& PolyGroup : InPolyGroups)
+    for (int32 i=0; i<IsolatedPointGroups.Num(); ++i)
+    {
+        if (ReferencePointResults[i])
         {
-            if (UGULPolyUtilityLibrary::IsPointOnPoly(
-                    ReferencePoint,
-                    PolyGroup.Points
-                    ) )
-            {
-                GridIds.Append(PointGroup.Points);
-                break;
-            }
+            GridIds.Append(IsolatedPointGroups[i].Points);
         }
     }
 }
@@ -944,26 +2290,27 @@ void UGULGridUtility::GenerateIsolatedGridsOnPoly(
             );
     }
 
-    for (FGULIntPointGroup& PointGroup : IsolatedPointGroups)
+    TArray<FVector2D> ReferencePoints;
+    GenerateIsolatedGroupReferencePoints(ReferencePoints, IsolatedPointGroups, GridSize);
+
+    // Classify isolated point groups against prepared poly groups
+
+    TArray<FGULPreparedPolyGroup> PreparedPolyGroups;
+    PreparedPolyGroups.Reserve(InIndexGroups.Num());
+
+    for (const FGULIndexedPolyGroup& IndexGroup : InIndexGroups)
+    {
+        PreparedPolyGroups.Emplace(IndexGroup, InPolyGroups);
+    }
+
+    TBitArray<> ReferencePointResults;
+    FGULPreparedPolyGroup::ClassifyPoints(ReferencePoints, ReferencePointResults, PreparedPolyGroups);
+
+    for (int32 i=0; i<IsolatedPointGroups.Num(); ++i)
     {
-        if (PointGroup.Points.Num() < 1)
+        if (ReferencePointResults[i])
         {
-            continue;
-        }
-
-        FVector2D ReferencePoint;
-        ReferencePoint.X = PointGroup.Points[0].X*GridSize;
-        ReferencePoint.Y = PointGroup.Points[0].Y*GridSize;
-        ReferencePoint.X += static_cast<float>(GridSize) * .5f;
-        ReferencePoint.Y += static_cast<float>(GridSize) * .5f;
-
-        if (UGULPolyUtilityLibrary::IsPointOnPoly(
-                ReferencePoint,
-                InIndexGroups,
-                InPolyGroups
-                ) )
-        {
-            GridIds.Append(PointGroup.Points);
+            GridIds.Append(IsolatedPointGroups[i].Points);
         }
     }
 }
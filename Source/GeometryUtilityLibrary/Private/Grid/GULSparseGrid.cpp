@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Grid/GULSparseGrid.h"
+#include "GULMathLibrary.h"
+#include "GULSortUtility.h"
+
+void FGULSparseGrid::Reset()
+{
+    Chunks.Reset();
+    ChunkMap.Reset();
+    CellCount = 0;
+}
+
+FGULSparseGrid::FChunk& FGULSparseGrid::FindOrAddChunk(const FIntPoint& ChunkId)
+{
+    const uint64 ChunkKey = UGULMathLibrary::PackGridKey(ChunkId);
+
+    if (const int32* ChunkIndex = ChunkMap.Find(ChunkKey))
+    {
+        return Chunks[*ChunkIndex];
+    }
+
+    ChunkMap.Emplace(ChunkKey, Chunks.Num());
+    return Chunks[Chunks.Emplace(ChunkId)];
+}
+
+const FGULSparseGrid::FChunk* FGULSparseGrid::FindChunk(const FIntPoint& ChunkId) const
+{
+    const int32* ChunkIndex = ChunkMap.Find(UGULMathLibrary::PackGridKey(ChunkId));
+    return ChunkIndex ? &Chunks[*ChunkIndex] : nullptr;
+}
+
+bool FGULSparseGrid::Contains(const FIntPoint& Point) const
+{
+    const FChunk* Chunk = FindChunk(GetChunkId(Point));
+
+    if (! Chunk)
+    {
+        return false;
+    }
+
+    const FIntPoint LocalPoint(GetChunkLocalPoint(Point));
+    return (Chunk->Rows[LocalPoint.Y] & (1ull << LocalPoint.X)) != 0;
+}
+
+bool FGULSparseGrid::Add(const FIntPoint& Point)
+{
+    FChunk& Chunk(FindOrAddChunk(GetChunkId(Point)));
+
+    const FIntPoint LocalPoint(GetChunkLocalPoint(Point));
+    const uint64 CellBit = 1ull << LocalPoint.X;
+    uint64& Row(Chunk.Rows[LocalPoint.Y]);
+
+    if (Row & CellBit)
+    {
+        return false;
+    }
+
+    Row |= CellBit;
+    ++Chunk.CellCount;
+    ++CellCount;
+
+    return true;
+}
+
+bool FGULSparseGrid::Remove(const FIntPoint& Point)
+{
+    const int32* ChunkIndex = ChunkMap.Find(UGULMathLibrary::PackGridKey(GetChunkId(Point)));
+
+    if (! ChunkIndex)
+    {
+        return false;
+    }
+
+    // Empty chunks are kept mapped and skipped on iteration
+
+    FChunk& Chunk(Chunks[*ChunkIndex]);
+
+    const FIntPoint LocalPoint(GetChunkLocalPoint(Point));
+    const uint64 CellBit = 1ull << LocalPoint.X;
+    uint64& Row(Chunk.Rows[LocalPoint.Y]);
+
+    if (! (Row & CellBit))
+    {
+        return false;
+    }
+
+    Row &= ~CellBit;
+    --Chunk.CellCount;
+    --CellCount;
+
+    return true;
+}
+
+void FGULSparseGrid::Append(TArrayView<const FIntPoint> Points)
+{
+    FChunk* Chunk = nullptr;
+    FIntPoint LastChunkId;
+
+    for (const FIntPoint& Point : Points)
+    {
+        const FIntPoint ChunkId(GetChunkId(Point));
+
+        // Consecutive points mostly share the same chunk
+        if (! Chunk || ChunkId != LastChunkId)
+        {
+            Chunk = &FindOrAddChunk(ChunkId);
+            LastChunkId = ChunkId;
+        }
+
+        const FIntPoint LocalPoint(GetChunkLocalPoint(Point));
+        const uint64 CellBit = 1ull << LocalPoint.X;
+        uint64& Row(Chunk->Rows[LocalPoint.Y]);
+
+        if (! (Row & CellBit))
+        {
+            Row |= CellBit;
+            ++Chunk->CellCount;
+            ++CellCount;
+        }
+    }
+}
+
+void FGULSparseGrid::Append(const FGULSparseGrid& Other)
+{
+    for (const FChunk& OtherChunk : Other.Chunks)
+    {
+        if (OtherChunk.IsEmpty())
+        {
+            continue;
+        }
+
+        FChunk& Chunk(FindOrAddChunk(OtherChunk.ChunkId));
+
+        CellCount -= Chunk.CellCount;
+        Chunk.CellCount = 0;
+
+        for (int32 y=0; y<ChunkSize; ++y)
+        {
+            Chunk.Rows[y] |= OtherChunk.Rows[y];
+            Chunk.CellCount += static_cast<int32>(FMath::CountBits(Chunk.Rows[y]));
+        }
+
+        CellCount += Chunk.CellCount;
+    }
+}
+
+bool FGULSparseGrid::GetBounds(FIntPoint& OutBoundsMin, FIntPoint& OutBoundsMax) const
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    OutBoundsMin = FIntPoint(MAX_int32, MAX_int32);
+    OutBoundsMax = FIntPoint(MIN_int32, MIN_int32);
+
+    for (const FChunk& Chunk : Chunks)
+    {
+        if (Chunk.IsEmpty())
+        {
+            continue;
+        }
+
+        const FIntPoint ChunkOrigin(GetChunkOrigin(Chunk.ChunkId));
+
+        uint64 ColumnMask = 0;
+
+        for (int32 y=0; y<ChunkSize; ++y)
+        {
+            const uint64 Row = Chunk.Rows[y];
+
+            if (Row)
+            {
+                OutBoundsMin.Y = FMath::Min(OutBoundsMin.Y, ChunkOrigin.Y+y);
+                OutBoundsMax.Y = FMath::Max(OutBoundsMax.Y, ChunkOrigin.Y+y);
+                ColumnMask |= Row;
+            }
+        }
+
+        OutBoundsMin.X = FMath::Min(OutBoundsMin.X, ChunkOrigin.X+CountTrailingZeros(ColumnMask));
+        OutBoundsMax.X = FMath::Max(OutBoundsMax.X, ChunkOrigin.X+FloorLog2(ColumnMask));
+    }
+
+    return true;
+}
+
+void FGULSparseGrid::GetSortedChunkIndices(TArray<int32>& OutChunkIndices) const
+{
+    TArray<uint64> ChunkKeys;
+    ChunkKeys.SetNumUninitialized(Chunks.Num());
+
+    for (int32 i=0; i<Chunks.Num(); ++i)
+    {
+        ChunkKeys[i] = UGULMathLibrary::PackGridKey(Chunks[i].ChunkId);
+    }
+
+    FGULSortUtility::RadixSortIndices(OutChunkIndices, TArrayView<const uint64>(ChunkKeys));
+}
+
+void FGULSparseGrid::ForEach(TFunctionRef<void(const FIntPoint&)> Callback) const
+{
+    TArray<int32> ChunkIndices;
+    GetSortedChunkIndices(ChunkIndices);
+
+    for (int32 ChunkIndex : ChunkIndices)
+    {
+        const FChunk& Chunk(Chunks[ChunkIndex]);
+
+        if (Chunk.IsEmpty())
+        {
+            continue;
+        }
+
+        const FIntPoint ChunkOrigin(GetChunkOrigin(Chunk.ChunkId));
+
+        for (int32 y=0; y<ChunkSize; ++y)
+        {
+            for (uint64 Bits=Chunk.Rows[y]; Bits; Bits&=Bits-1)
+            {
+                Callback(FIntPoint(ChunkOrigin.X+CountTrailingZeros(Bits), ChunkOrigin.Y+y));
+            }
+        }
+    }
+}
+
+void FGULSparseGrid::ToPoints(TArray<FIntPoint>& OutPoints) const
+{
+    OutPoints.Reset(CellCount);
+
+    ForEach([&OutPoints](const FIntPoint& Point)
+    {
+        OutPoints.Emplace(Point);
+    } );
+}
+
+bool FGULGridSparseCellStates::Init(const FGULSparseGrid& InBoundaryGrid)
+{
+    BoundaryGrid = &InBoundaryGrid;
+    BoundaryChunkIndices.Reset();
+    VisitedChunkIndices.Reset();
+    VisitedChunks.Reset();
+
+    if (! InBoundaryGrid.GetBounds(BoundsMin, BoundsMax))
+    {
+        BoundsMin = FIntPoint::ZeroValue;
+        BoundsMax = FIntPoint(-1, -1);
+        Stride = 0;
+        return false;
+    }
+
+    const int32 SizeX = BoundsMax.X-BoundsMin.X+1;
+    const int32 SizeY = BoundsMax.Y-BoundsMin.Y+1;
+
+    StrideLog2 = FMath::CeilLogTwo(static_cast<uint32>(SizeX));
+    Stride = 1 << StrideLog2;
+
+    check(static_cast<int64>(Stride)*SizeY <= MAX_int32);
+
+    // Map occupied boundary chunks to chunk slots
+
+    ChunkMin = FGULSparseGrid::GetChunkId(BoundsMin);
+
+    const FIntPoint ChunkMax(FGULSparseGrid::GetChunkId(BoundsMax));
+    const int32 ChunkCountY = ChunkMax.Y-ChunkMin.Y+1;
+
+    ChunkCountX = ChunkMax.X-ChunkMin.X+1;
+
+    BoundaryChunkIndices.Init(INDEX_NONE, ChunkCountX*ChunkCountY);
+    VisitedChunkIndices.Init(INDEX_NONE, ChunkCountX*ChunkCountY);
+
+    const TArray<FGULSparseGrid::FChunk>& Chunks(InBoundaryGrid.GetChunks());
+
+    for (int32 ChunkIt=0; ChunkIt<Chunks.Num(); ++ChunkIt)
+    {
+        const FGULSparseGrid::FChunk& Chunk(Chunks[ChunkIt]);
+
+        if (! Chunk.IsEmpty())
+        {
+            BoundaryChunkIndices[GetChunkSlot(FGULSparseGrid::GetChunkOrigin(Chunk.ChunkId))] = ChunkIt;
+        }
+    }
+
+    return true;
+}
+
+void FGULGridSparseCellStates::SetVisitedRange(int32 Index, int32 Count)
+{
+    FIntPoint Point(GetPoint(Index));
+    const int32 X1 = Point.X+Count-1;
+
+    // Set row bits chunk by chunk
+
+    while (Point.X <= X1)
+    {
+        const int32 LocalX0 = Point.X & FGULSparseGrid::ChunkMask;
+        const int32 LocalX1 = FMath::Min(X1-Point.X+LocalX0, static_cast<int32>(FGULSparseGrid::ChunkMask));
+        const int32 BitCount = LocalX1-LocalX0+1;
+        const uint64 Bits = (BitCount < 64) ? ((1ull << BitCount)-1) : ~0ull;
+
+        FindOrAddVisitedRow(Point) |= Bits << LocalX0;
+
+        Point.X += BitCount;
+    }
+}
@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "PDS/GULPDSChunkSampler.h"
+#include "GeometryUtilityLibrary.h"
+
+void UGULPDSChunkSampler::Initialize(float ChunkSize, int32 RandomSeed, float PointRadius, int32 KValue)
+{
+    Sampler = MakeUnique<FGULPoissonDiscChunkSampler>(ChunkSize, PointRadius, RandomSeed, KValue);
+}
+
+bool UGULPDSChunkSampler::HasValidConfig() const
+{
+    return Sampler.IsValid() && Sampler->HasValidConfig();
+}
+
+void UGULPDSChunkSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FIntPoint ChunkId)
+{
+    OutPoints.Reset();
+
+    if (! HasValidConfig())
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULPDSChunkSampler::GeneratePoints() ABORTED, INVALID SAMPLER CONFIG"));
+        return;
+    }
+
+    Sampler->GeneratePoints(OutPoints, ChunkId);
+}
+
+FIntPoint UGULPDSChunkSampler::GetChunkId(FVector2D Point) const
+{
+    return HasValidConfig() ? Sampler->GetChunkId(Point) : FIntPoint::ZeroValue;
+}
+
+FBox2D UGULPDSChunkSampler::GetChunkBounds(FIntPoint ChunkId) const
+{
+    return HasValidConfig() ? Sampler->GetChunkBounds(ChunkId) : FBox2D(ForceInitToZero);
+}
+
+int32 UGULPDSChunkSampler::GetCachedChunkNum() const
+{
+    return Sampler.IsValid() ? Sampler->GetCachedChunkNum() : 0;
+}
+
+void UGULPDSChunkSampler::ResetCache()
+{
+    if (Sampler.IsValid())
+    {
+        Sampler->ResetCache();
+    }
+}
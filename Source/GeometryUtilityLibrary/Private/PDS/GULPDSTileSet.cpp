@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "PDS/GULPDSTileSet.h"
+#include "GeometryUtilityLibrary.h"
+
+void UGULPDSTileSet::Initialize(int32 RandomSeed, float TileSize, int32 EdgeColorCount, int32 InteriorVariantCount, int32 KValue)
+{
+    TileSet = MakeUnique<FGULPoissonDiscTileSet>(RandomSeed, TileSize, EdgeColorCount, InteriorVariantCount, KValue);
+}
+
+bool UGULPDSTileSet::HasValidTileSet() const
+{
+    return TileSet.IsValid() && TileSet->GetTileNum() > 0;
+}
+
+void UGULPDSTileSet::GeneratePoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed, float PointRadius) const
+{
+    OutPoints.Reset();
+
+    if (! HasValidTileSet())
+    {
+        UE_LOG(LogGUL,Warning, TEXT("UGULPDSTileSet::GeneratePoints() ABORTED, UNINITIALIZED TILE SET"));
+        return;
+    }
+
+    TileSet->GeneratePoints(OutPoints, Bounds, PointRadius, RandomSeed);
+}
+
+float UGULPDSTileSet::GetTileSize() const
+{
+    return TileSet.IsValid() ? TileSet->GetTileSize() : 0.f;
+}
+
+int32 UGULPDSTileSet::GetTileNum() const
+{
+    return TileSet.IsValid() ? TileSet->GetTileNum() : 0;
+}
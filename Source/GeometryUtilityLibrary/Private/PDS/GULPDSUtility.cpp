@@ -27,6 +27,7 @@
 
 #include "PDS/GULPDSUtility.h"
 #include "PDS/GULPoissonDiscSampler.h"
+#include "PDS/GULPoissonDiscChunkSampler.h"
 
 void UGULPDSUtility::GeneratePoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed, float PointRadius, int32 KValue)
 {
@@ -39,3 +40,34 @@ void UGULPDSUtility::GeneratePoints(TArray<FVector2D>& OutPoints, FBox2D Bounds,
         Sampler.GeneratePoints(OutPoints, RandomSeed);
     }
 }
+
+void UGULPDSUtility::GeneratePointsParallel(TArray<FVector2D>& OutPoints, FBox2D Bounds, int32 RandomSeed, float PointRadius, int32 KValue, int32 TileCellSize)
+{
+    OutPoints.Reset();
+
+    FGULPoissonDiscSampler Sampler(Bounds, PointRadius, KValue);
+
+    if (Sampler.HasValidConfig())
+    {
+        Sampler.GeneratePointsParallel(OutPoints, RandomSeed, TileCellSize);
+    }
+}
+
+void UGULPDSUtility::GeneratePolyGroupPoints(TArray<FVector2D>& OutPoints, FBox2D Bounds, const TArray<FGULIndexedPolyGroup>& IndexGroups, const TArray<FGULVector2DGroup>& PolyGroups, int32 RandomSeed, float PointRadius, int32 KValue)
+{
+    OutPoints.Reset();
+
+    FGULPoissonDiscSampler Sampler(Bounds, PointRadius, KValue);
+
+    if (Sampler.HasValidConfig())
+    {
+        FRandomStream Rand(RandomSeed);
+        Sampler.GeneratePoints(OutPoints, Rand, IndexGroups, PolyGroups);
+    }
+}
+
+void UGULPDSUtility::GenerateChunkPoints(TArray<FVector2D>& OutPoints, FIntPoint ChunkId, float ChunkSize, int32 RandomSeed, float PointRadius, int32 KValue)
+{
+    FGULPoissonDiscChunkSampler Sampler(ChunkSize, PointRadius, RandomSeed, KValue);
+    Sampler.GeneratePoints(OutPoints, ChunkId);
+}
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "PDS/GULPoissonDiscChunkSampler.h"
+#include "Misc/Crc.h"
+#include "PDS/GULPoissonDiscSampler.h"
+
+FGULPoissonDiscChunkSampler::FGULPoissonDiscChunkSampler(
+    float InChunkSize,
+    float InPointRadius,
+    int32 InRandomSeed,
+    int32 InKValue,
+    const FVector2D& InOrigin
+    )
+    : Origin(InOrigin)
+    , ChunkSize(InChunkSize)
+    , PointRadius(InPointRadius)
+    , RandomSeed(InRandomSeed)
+    , KValue(InKValue)
+{
+}
+
+void FGULPoissonDiscChunkSampler::ResetCache()
+{
+    BorderCache.Empty();
+}
+
+void FGULPoissonDiscChunkSampler::GenerateChunk(TArray<FVector2D>& OutPoints, const FIntPoint& ChunkId) const
+{
+    const int32 Phase = GetChunkPhase(ChunkId);
+
+    // Gather cached border points of lower phase neighbours
+
+    TArray<FVector2D> BorderPoints;
+
+    for (int32 y=-1; y<=1; ++y)
+    for (int32 x=-1; x<=1; ++x)
+    {
+        const FIntPoint NeighbourId(ChunkId.X+x, ChunkId.Y+y);
+
+        if (GetChunkPhase(NeighbourId) < Phase)
+        {
+            const TArray<FVector2D>* NeighbourPoints = BorderCache.Find(NeighbourId);
+            check(NeighbourPoints != nullptr);
+            BorderPoints.Append(*NeighbourPoints);
+        }
+    }
+
+    // Sample chunk with chunk id seeded random stream
+
+    FGULPoissonDiscSampler Sampler(GetChunkBounds(ChunkId), 1.f, KValue);
+    Sampler.SetPointRadius(PointRadius);
+
+    if (! Sampler.HasValidConfig())
+    {
+        return;
+    }
+
+    FRandomStream Rand(static_cast<int32>(FCrc::MemCrc32(&ChunkId, sizeof(FIntPoint), static_cast<uint32>(RandomSeed))));
+
+    Sampler.GeneratePoints(OutPoints, Rand, BorderPoints);
+}
+
+void FGULPoissonDiscChunkSampler::CacheBorderPoints(const FIntPoint& ChunkId, const TArray<FVector2D>& Points)
+{
+    if (BorderCache.Contains(ChunkId))
+    {
+        return;
+    }
+
+    // Only points within radius of chunk edges could constrain neighbours
+
+    const FBox2D Bounds(GetChunkBounds(ChunkId));
+    const FBox2D InnerBounds(Bounds.Min+PointRadius, Bounds.Max-PointRadius);
+
+    TArray<FVector2D>& BorderPoints(BorderCache.Add(ChunkId));
+
+    for (const FVector2D& Point : Points)
+    {
+        if (Point.X < InnerBounds.Min.X || Point.X >= InnerBounds.Max.X ||
+            Point.Y < InnerBounds.Min.Y || Point.Y >= InnerBounds.Max.Y)
+        {
+            BorderPoints.Emplace(Point);
+        }
+    }
+}
+
+void FGULPoissonDiscChunkSampler::GenerateNeighbourBorderPoints(const FIntPoint& ChunkId)
+{
+    const int32 Phase = GetChunkPhase(ChunkId);
+
+    for (int32 y=-1; y<=1; ++y)
+    for (int32 x=-1; x<=1; ++x)
+    {
+        const FIntPoint NeighbourId(ChunkId.X+x, ChunkId.Y+y);
+
+        if (GetChunkPhase(NeighbourId) < Phase && ! BorderCache.Contains(NeighbourId))
+        {
+            GenerateNeighbourBorderPoints(NeighbourId);
+
+            TArray<FVector2D> NeighbourPoints;
+            GenerateChunk(NeighbourPoints, NeighbourId);
+            CacheBorderPoints(NeighbourId, NeighbourPoints);
+        }
+    }
+}
+
+void FGULPoissonDiscChunkSampler::GeneratePoints(TArray<FVector2D>& OutPoints, const FIntPoint& ChunkId)
+{
+    OutPoints.Reset();
+
+    if (! HasValidConfig())
+    {
+        return;
+    }
+
+    GenerateNeighbourBorderPoints(ChunkId);
+    GenerateChunk(OutPoints, ChunkId);
+    CacheBorderPoints(ChunkId, OutPoints);
+}
@@ -26,6 +26,15 @@
 // 
 
 #include "PDS/GULPoissonDiscSampler.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+#include "Grid/GULGridScanConverter.h"
+#include "Poly/GULPolyTypes.h"
+#include "Poly/GULPreparedPoly.h"
+
+// Inline grid empty cell coordinate, far enough that squared distances to
+// any sample exceed the sample radius while staying finite
+#define GUL_PDS_EMPTY_CELL_COORD 1.e18f
 
 FGULPoissonDiscSampler::FGULPoissonDiscSampler(FBox2D InBounds, float InRadius, int32 InKValue)
 {
@@ -57,23 +66,19 @@ void FGULPoissonDiscSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FRando
 {
     check(HasValidConfig());
 
-    RadiusSq = PointRadius * PointRadius;
-    CellSize = PointRadius * UE_INV_SQRT_2;
-    CellSizeInv = 1.f/CellSize;
-
-    const float KInv = 1.f/static_cast<float>(KValue);
+    const bool bInlineGrid = (GridMode == EGULPoissonDiscGridMode::Inline);
 
-    FVector2D GridSize(Bounds.GetSize());
-    DimX = FMath::CeilToInt(GridSize.X * CellSizeInv);
-    DimY = FMath::CeilToInt(GridSize.Y * CellSizeInv);
+    InitGrid(bInlineGrid);
 
-    // Initialize grid point sample indices with invalid indices
-    Grid.SetNumUninitialized(DimX * DimY);
-    FMemory::Memset(Grid.GetData(), 0xFF, Grid.Num()*Grid.GetTypeSize());
+    const float KInv = 1.f/static_cast<float>(KValue);
+    const FVector2D GridSize(Bounds.GetSize());
 
     TArray<int32> Queue;
     TArray<FVector2D> Points;
 
+    // Reserve point storage by the hexagonal packing sample count estimate
+    Points.Reserve(FMath::CeilToInt(Bounds.GetArea() / (RadiusSq*.866f)) + 1);
+
     // Pick the first sample within bounds
     {
         FVector2D InitialPoint = Bounds.Min + Rand.GetFraction()*GridSize;
@@ -81,7 +86,15 @@ void FGULPoissonDiscSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FRando
         int32 PointIndex = Points.Emplace(InitialPoint);
 
         Queue.Emplace(PointIndex);
-        SetSample(GetCell(InitialPoint), PointIndex);
+
+        if (bInlineGrid)
+        {
+            SetSamplePoint(GetCell(InitialPoint), InitialPoint);
+        }
+        else
+        {
+            SetSample(GetCell(InitialPoint), PointIndex);
+        }
     }
 
     // Pick a random existing sample from the queue
@@ -108,13 +121,23 @@ void FGULPoissonDiscSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FRando
             // and farther than 2 * radius to all existing samples
             if (Bounds.Min.X <= Point.X && Point.X < Bounds.Max.X &&
                 Bounds.Min.Y <= Point.Y && Point.Y < Bounds.Max.Y &&
-                IsWithinValidPointRadius(Point, Points)
+                (bInlineGrid
+                    ? IsWithinValidPointRadiusInline(Point)
+                    : IsWithinValidPointRadius(Point, Points))
                 )
             {
                 int32 PointIndex = Points.Emplace(Point);
 
                 Queue.Emplace(PointIndex);
-                SetSample(GetCell(Point), PointIndex);
+
+                if (bInlineGrid)
+                {
+                    SetSamplePoint(GetCell(Point), Point);
+                }
+                else
+                {
+                    SetSample(GetCell(Point), PointIndex);
+                }
 
                 bHasNewPoint = true;
 
@@ -132,6 +155,461 @@ void FGULPoissonDiscSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FRando
     OutPoints = MoveTemp(Points);
 }
 
+void FGULPoissonDiscSampler::GeneratePoints(TArray<FVector2D>& OutPoints, FRandomStream& Rand, TArrayView<const FVector2D> BorderPoints)
+{
+    check(HasValidConfig());
+
+    InitGrid(true);
+
+    // Assign border points within the padded grid, farther points could not
+    // be within radius of any sample
+
+    for (const FVector2D& Point : BorderPoints)
+    {
+        const FIntPoint Cell(GetCell(Point));
+
+        if (Cell.X >= -CellPadding && Cell.X < DimX+CellPadding &&
+            Cell.Y >= -CellPadding && Cell.Y < DimY+CellPadding)
+        {
+            CellPoints[GetCellPointIndex(Cell.X, Cell.Y)] = Point;
+        }
+    }
+
+    OutPoints.Reset();
+
+    SampleTile(OutPoints, FIntPoint(0, 0), FIntPoint(DimX-1, DimY-1), Rand);
+}
+
+void FGULPoissonDiscSampler::GeneratePoints(
+    TArray<FVector2D>& OutPoints,
+    FRandomStream& Rand,
+    const TArray<FGULIndexedPolyGroup>& IndexGroups,
+    const TArray<FGULVector2DGroup>& PolyGroups
+    )
+{
+    check(HasValidConfig());
+
+    InitGrid(true);
+
+    OutPoints.Reset();
+
+    // Prepare poly groups and convert poly rings into grid cell space.
+    //
+    // Shape converter generates cells with centers inside poly groups. Edge
+    // converter receives each ring edge as a degenerate two point ring, its
+    // even-odd fill is empty and it only generates cells touched by edges.
+
+    TArray<FGULPreparedPolyGroup> PreparedGroups;
+    PreparedGroups.Reserve(IndexGroups.Num());
+
+    FGULGridScanConverter ShapeConverter;
+    FGULGridScanConverter EdgeConverter;
+
+    EdgeConverter.AddShape();
+
+    TArray<FVector2D> RingPoints;
+
+    auto AddRing = [&](const FGULVector2DGroup& Ring)
+    {
+        RingPoints.Reset(Ring.Points.Num());
+
+        for (const FVector2D& Point : Ring.Points)
+        {
+            RingPoints.Emplace((Point-Bounds.Min) * CellSizeInv);
+        }
+
+        ShapeConverter.AddRing(RingPoints);
+
+        for (int32 i=0, j=RingPoints.Num()-1; i<RingPoints.Num(); j=i++)
+        {
+            if (RingPoints[j] != RingPoints[i])
+            {
+                const FVector2D EdgePoints[2] = { RingPoints[j], RingPoints[i] };
+                EdgeConverter.AddRing(MakeArrayView(EdgePoints, 2));
+            }
+        }
+    };
+
+    for (const FGULIndexedPolyGroup& IndexGroup : IndexGroups)
+    {
+        if (! IndexGroup.IsValidIndexGroup(PolyGroups))
+        {
+            continue;
+        }
+
+        PreparedGroups.Emplace(IndexGroup, PolyGroups);
+
+        ShapeConverter.AddShape();
+        AddRing(IndexGroup.GetOuter(PolyGroups));
+
+        for (int32 i=0; i<IndexGroup.GetInnerNum(); ++i)
+        {
+            AddRing(IndexGroup.GetInner(PolyGroups, i));
+        }
+    }
+
+    if (! ShapeConverter.HasEdges())
+    {
+        return;
+    }
+
+    // Rasterize cell mask
+
+    enum ECellMask : uint8
+    {
+        Outside,
+        Inside,
+        Boundary
+    };
+
+    TArray<uint8> CellMask;
+    CellMask.SetNumZeroed(DimX * DimY);
+
+    auto FillSpans = [&](const TArray<FGULGridSpan>& Spans, uint8 Value)
+    {
+        for (const FGULGridSpan& Span : Spans)
+        {
+            if (Span.Y < 0 || Span.Y >= DimY)
+            {
+                continue;
+            }
+
+            const int32 X0 = FMath::Max(Span.X0, 0);
+            const int32 X1 = FMath::Min(Span.X1, DimX-1);
+
+            for (int32 x=X0; x<=X1; ++x)
+            {
+                CellMask[GetIndex(x, Span.Y)] = Value;
+            }
+        }
+    };
+
+    {
+        TArray<FGULGridSpan> Spans;
+
+        ShapeConverter.GenerateSpans(Spans, 64, false);
+        FillSpans(Spans, Inside);
+
+        EdgeConverter.GenerateSpans(Spans, 64, true);
+        FillSpans(Spans, Boundary);
+    }
+
+    TArray<FVector2D> Queue;
+
+    auto TryAddPoint = [&](const FVector2D& Point)
+    {
+        if (! (Bounds.Min.X <= Point.X && Point.X < Bounds.Max.X &&
+               Bounds.Min.Y <= Point.Y && Point.Y < Bounds.Max.Y))
+        {
+            return false;
+        }
+
+        const FIntPoint Cell(GetCell(Point));
+        const uint8 Mask = CellMask[GetIndex(Cell.X, Cell.Y)];
+
+        if (Mask == Outside || ! IsWithinValidPointRadiusInline(Point))
+        {
+            return false;
+        }
+
+        // Exact poly group test on edge cells
+        if (Mask == Boundary)
+        {
+            const FIntPoint ScaledPoint(UGULMathLibrary::ScaleToIntPoint(Point));
+            bool bIsOnPoly = false;
+
+            for (const FGULPreparedPolyGroup& PreparedGroup : PreparedGroups)
+            {
+                if (PreparedGroup.GetBounds().IsInside(Point) && PreparedGroup.IsPointOnPoly(ScaledPoint))
+                {
+                    bIsOnPoly = true;
+                    break;
+                }
+            }
+
+            if (! bIsOnPoly)
+            {
+                return false;
+            }
+        }
+
+        OutPoints.Emplace(Point);
+        Queue.Emplace(Point);
+        SetSamplePoint(Cell, Point);
+
+        return true;
+    };
+
+    const float KInv = 1.f/static_cast<float>(KValue);
+
+    // Seed empty inside and edge cells in grid order, grow samples from
+    // each accepted seed before seeding the next cell
+
+    for (int32 y=0; y<DimY; ++y)
+    for (int32 x=0; x<DimX; ++x)
+    {
+        const uint8 Mask = CellMask[GetIndex(x, y)];
+
+        if (Mask == Outside || CellPoints[GetCellPointIndex(x, y)].X != GUL_PDS_EMPTY_CELL_COORD)
+        {
+            continue;
+        }
+
+        // Inside cell darts are always on poly, edge cells may take several
+        // darts to land on poly
+        const int32 DartCount = (Mask == Inside) ? 1 : KValue;
+        const FVector2D CellMin(Bounds.Min + FVector2D(x, y)*CellSize);
+
+        for (int32 DartIt=0; DartIt<DartCount; ++DartIt)
+        {
+            const FVector2D Dart(CellMin + FVector2D(Rand.GetFraction(), Rand.GetFraction())*CellSize);
+
+            if (TryAddPoint(Dart))
+            {
+                break;
+            }
+        }
+
+        while (Queue.Num() > 0)
+        {
+            const int32 i = Rand.RandHelper(Queue.Num());
+            const FVector2D ParentPoint(Queue[i]);
+
+            const float RandFrac = Rand.GetFraction();
+            bool bHasNewPoint = false;
+
+            for (int32 j=0; j<KValue; ++j)
+            {
+                const float a = 2.f * PI * (RandFrac + static_cast<float>(j)*KInv);
+                const float r = PointRadius + SMALL_NUMBER;
+
+                FVector2D Point;
+                Point.X = ParentPoint.X + r * FMath::Cos(a);
+                Point.Y = ParentPoint.Y + r * FMath::Sin(a);
+
+                if (TryAddPoint(Point))
+                {
+                    bHasNewPoint = true;
+                    break;
+                }
+            }
+
+            // If none of k candidates were accepted, remove it from the queue
+            if (! bHasNewPoint)
+            {
+                Queue.RemoveAtSwap(i, 1, false);
+            }
+        }
+    }
+}
+
+void FGULPoissonDiscSampler::GeneratePointsParallel(TArray<FVector2D>& OutPoints, int32 RandomSeed, int32 TileCellSize)
+{
+    check(HasValidConfig());
+
+    InitGrid(true);
+
+    TileCellSize = FMath::Max(2, TileCellSize);
+
+    const int32 TileCountX = FMath::DivideAndRoundUp(DimX, TileCellSize);
+    const int32 TileCountY = FMath::DivideAndRoundUp(DimY, TileCellSize);
+
+    TArray< TArray<FVector2D> > TilePoints;
+    TilePoints.SetNum(TileCountX * TileCountY);
+
+    // Sample tiles in 2x2 phase groups. Tiles of the same phase are separated
+    // by at least one tile of at least 2 cells, farther than both the sample
+    // radius and the neighbour test window, so tiles of one phase never
+    // access each other's cells and are sampled concurrently.
+
+    for (int32 Phase=0; Phase<4; ++Phase)
+    {
+        const int32 PhaseX = Phase & 1;
+        const int32 PhaseY = Phase >> 1;
+        const int32 PhaseCountX = (TileCountX-PhaseX+1) / 2;
+        const int32 PhaseCountY = (TileCountY-PhaseY+1) / 2;
+
+        ParallelFor(PhaseCountX * PhaseCountY, [&](int32 PhaseTileIndex)
+        {
+            const FIntPoint TileId(
+                PhaseX + (PhaseTileIndex % PhaseCountX) * 2,
+                PhaseY + (PhaseTileIndex / PhaseCountX) * 2
+                );
+
+            const FIntPoint CellMin(TileId.X*TileCellSize, TileId.Y*TileCellSize);
+            const FIntPoint CellMax(
+                FMath::Min(CellMin.X+TileCellSize, DimX) - 1,
+                FMath::Min(CellMin.Y+TileCellSize, DimY) - 1
+                );
+
+            // Per tile random stream, independent of tile sampling order
+            FRandomStream Rand(static_cast<int32>(FCrc::MemCrc32(&TileId, sizeof(FIntPoint), static_cast<uint32>(RandomSeed))));
+
+            SampleTile(TilePoints[TileId.X + TileId.Y*TileCountX], CellMin, CellMax, Rand);
+        } );
+    }
+
+    // Gather tile points in tile order
+
+    int32 PointCount = 0;
+
+    for (const TArray<FVector2D>& Points : TilePoints)
+    {
+        PointCount += Points.Num();
+    }
+
+    OutPoints.Reset(PointCount);
+
+    for (const TArray<FVector2D>& Points : TilePoints)
+    {
+        OutPoints.Append(Points);
+    }
+}
+
+void FGULPoissonDiscSampler::SampleTile(
+    TArray<FVector2D>& OutPoints,
+    const FIntPoint& CellMin,
+    const FIntPoint& CellMax,
+    FRandomStream& Rand
+    )
+{
+    const float KInv = 1.f/static_cast<float>(KValue);
+
+    const FVector2D TileMin(Bounds.Min + FVector2D(CellMin.X, CellMin.Y)*CellSize);
+    const FVector2D TileSize(
+        FMath::Min(Bounds.Max.X, Bounds.Min.X + (CellMax.X+1)*CellSize) - TileMin.X,
+        FMath::Min(Bounds.Max.Y, Bounds.Min.Y + (CellMax.Y+1)*CellSize) - TileMin.Y
+        );
+
+    TArray<FVector2D> Queue;
+
+    auto TryAddPoint = [&](const FVector2D& Point)
+    {
+        if (! (Bounds.Min.X <= Point.X && Point.X < Bounds.Max.X &&
+               Bounds.Min.Y <= Point.Y && Point.Y < Bounds.Max.Y))
+        {
+            return false;
+        }
+
+        // Only accept points on tile cells
+        const FIntPoint Cell(GetCell(Point));
+
+        if (Cell.X < CellMin.X || Cell.Y < CellMin.Y ||
+            Cell.X > CellMax.X || Cell.Y > CellMax.Y ||
+            ! IsWithinValidPointRadiusInline(Point))
+        {
+            return false;
+        }
+
+        OutPoints.Emplace(Point);
+        Queue.Emplace(Point);
+        SetSamplePoint(Cell, Point);
+
+        return true;
+    };
+
+    // Seed queue with samples of previously sampled neighbour tiles within
+    // the neighbour test window, tile grows from its borders
+
+    for (int32 y=CellMin.Y-CellPadding; y<=CellMax.Y+CellPadding; ++y)
+    for (int32 x=CellMin.X-CellPadding; x<=CellMax.X+CellPadding; ++x)
+    {
+        if (x >= CellMin.X && x <= CellMax.X && y >= CellMin.Y && y <= CellMax.Y)
+        {
+            continue;
+        }
+
+        const FVector2D& CellPoint(CellPoints[GetCellPointIndex(x, y)]);
+
+        if (CellPoint.X != GUL_PDS_EMPTY_CELL_COORD)
+        {
+            Queue.Emplace(CellPoint);
+        }
+    }
+
+    // Grow samples from queue, then throw up to k random darts into the tile
+    // to seed regions not reached from neighbour samples
+
+    for (int32 DartIt=0; DartIt<=KValue; ++DartIt)
+    {
+        if (DartIt > 0)
+        {
+            FVector2D Dart;
+            Dart.X = TileMin.X + Rand.GetFraction()*TileSize.X;
+            Dart.Y = TileMin.Y + Rand.GetFraction()*TileSize.Y;
+
+            TryAddPoint(Dart);
+        }
+
+        while (Queue.Num() > 0)
+        {
+            const int32 i = Rand.RandHelper(Queue.Num());
+            const FVector2D ParentPoint(Queue[i]);
+
+            const float RandFrac = Rand.GetFraction();
+            bool bHasNewPoint = false;
+
+            for (int32 j=0; j<KValue; ++j)
+            {
+                const float a = 2.f * PI * (RandFrac + static_cast<float>(j)*KInv);
+                const float r = PointRadius + SMALL_NUMBER;
+
+                FVector2D Point;
+                Point.X = ParentPoint.X + r * FMath::Cos(a);
+                Point.Y = ParentPoint.Y + r * FMath::Sin(a);
+
+                if (TryAddPoint(Point))
+                {
+                    bHasNewPoint = true;
+                    break;
+                }
+            }
+
+            // If none of k candidates were accepted, remove it from the queue
+            if (! bHasNewPoint)
+            {
+                Queue.RemoveAtSwap(i, 1, false);
+            }
+        }
+    }
+}
+
+void FGULPoissonDiscSampler::InitGrid(bool bInlineGrid)
+{
+    RadiusSq = PointRadius * PointRadius;
+    CellSize = PointRadius * UE_INV_SQRT_2;
+    CellSizeInv = 1.f/CellSize;
+
+    const FVector2D GridSize(Bounds.GetSize());
+    DimX = FMath::CeilToInt(GridSize.X * CellSizeInv);
+    DimY = FMath::CeilToInt(GridSize.Y * CellSizeInv);
+
+    if (bInlineGrid)
+    {
+        Grid.Empty();
+
+        // Initialize padded grid with empty cell positions
+        CellStride = DimX + CellPadding*2;
+        CellPoints.Reset();
+        CellPoints.SetNumUninitialized(CellStride * (DimY + CellPadding*2));
+
+        const FVector2D EmptyPoint(GUL_PDS_EMPTY_CELL_COORD, GUL_PDS_EMPTY_CELL_COORD);
+
+        for (FVector2D& CellPoint : CellPoints)
+        {
+            CellPoint = EmptyPoint;
+        }
+    }
+    else
+    {
+        CellPoints.Empty();
+
+        // Initialize grid point sample indices with invalid indices
+        Grid.SetNumUninitialized(DimX * DimY);
+        FMemory::Memset(Grid.GetData(), 0xFF, Grid.Num()*Grid.GetTypeSize());
+    }
+}
+
 bool FGULPoissonDiscSampler::IsWithinValidPointRadius(const FVector2D& Point, const TArray<FVector2D>& Points) const
 {
     const FIntPoint Cell(GetCell(Point));
@@ -163,3 +641,34 @@ bool FGULPoissonDiscSampler::IsWithinValidPointRadius(const FVector2D& Point, co
 
     return true;
 }
+
+bool FGULPoissonDiscSampler::IsWithinValidPointRadiusInline(const FVector2D& Point) const
+{
+    const FIntPoint Cell(GetCell(Point));
+
+    // Cell size is radius / sqrt(2), samples on the 5x5 window corner cells
+    // are always at least one radius away and are skipped
+    const int32 RowOffsets[5] = { 1, 0, 0, 0, 1 };
+
+    for (int32 dy=0; dy<5; ++dy)
+    {
+        const int32 RowOffset = RowOffsets[dy];
+        const int32 CellCount = 5 - RowOffset*2;
+        const FVector2D* RowPoints = CellPoints.GetData() + GetCellPointIndex(Cell.X-2+RowOffset, Cell.Y-2+dy);
+
+        bool bIsWithinRadius = false;
+
+        for (int32 dx=0; dx<CellCount; ++dx)
+        {
+            bIsWithinRadius |= (Point-RowPoints[dx]).SizeSquared() < RadiusSq;
+        }
+
+        // Point is within another point radius, invalid point
+        if (bIsWithinRadius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "PDS/GULPoissonDiscTileSet.h"
+#include "Misc/Crc.h"
+#include "PDS/GULPoissonDiscSampler.h"
+
+// Tile generation point radius, slightly above unit radius to absorb
+// rounding when scaling and translating tile points to the output
+#define GUL_PDS_TILE_RADIUS 1.0001f
+
+// Minimum tile size, corner patches and bands of opposite tile sides must
+// be at least one radius apart
+#define GUL_PDS_TILE_SIZE_MIN 4.f
+
+FGULPoissonDiscTileSet::FGULPoissonDiscTileSet(
+    int32 InRandomSeed,
+    float InTileSize,
+    int32 InEdgeColorCount,
+    int32 InInteriorVariantCount,
+    int32 InKValue
+    )
+    : TileSize(FMath::Max(GUL_PDS_TILE_SIZE_MIN, InTileSize) * GUL_PDS_TILE_RADIUS)
+    , EdgeColorCount(FMath::Max(1, InEdgeColorCount))
+    , InteriorVariantCount(FMath::Max(1, InInteriorVariantCount))
+{
+    Build(InRandomSeed, FMath::Max(1, InKValue));
+}
+
+uint32 FGULPoissonDiscTileSet::GetHash(int32 A, int32 B, int32 C, int32 Seed)
+{
+    const int32 Data[3] = { A, B, C };
+    uint32 Hash = FCrc::MemCrc32(Data, sizeof(Data), static_cast<uint32>(Seed));
+
+    // CRC is affine in its seed, apply avalanche finalizer so that seeds
+    // select uncorrelated edge colour arrangements
+
+    Hash ^= Hash >> 16;
+    Hash *= 0x85ebca6bu;
+    Hash ^= Hash >> 13;
+    Hash *= 0xc2b2ae35u;
+    Hash ^= Hash >> 16;
+
+    return Hash;
+}
+
+void FGULPoissonDiscTileSet::Build(int32 RandomSeed, int32 KValue)
+{
+    const float Radius = GUL_PDS_TILE_RADIUS;
+    const float T = TileSize;
+
+    // Edge band half width, interiors of adjacent tiles are one radius apart
+    const float w = Radius * .5f;
+
+    // Corner patch half size, horizontal and vertical bands meeting at a
+    // corner patch are at least one radius apart
+    const float c = Radius * 1.25f;
+
+    auto SamplePatch = [&](
+        TArray<FVector2D>& OutPoints,
+        const FBox2D& PatchBounds,
+        const TArray<FVector2D>& BorderPoints,
+        uint32 PatchSeed
+        )
+    {
+        FGULPoissonDiscSampler Sampler(PatchBounds, 1.f, KValue);
+        Sampler.SetPointRadius(Radius);
+
+        FRandomStream Rand(static_cast<int32>(PatchSeed));
+        Sampler.GeneratePoints(OutPoints, Rand, BorderPoints);
+    };
+
+    auto AppendTranslated = [](TArray<FVector2D>& OutPoints, const TArray<FVector2D>& Points, const FVector2D& Offset)
+    {
+        for (const FVector2D& Point : Points)
+        {
+            OutPoints.Emplace(Point + Offset);
+        }
+    };
+
+    // Corner patch
+
+    TArray<FVector2D> CornerPoints;
+
+    SamplePatch(
+        CornerPoints,
+        FBox2D(FVector2D(-c, -c), FVector2D(c, c)),
+        TArray<FVector2D>(),
+        GetHash(0, 0, 0, RandomSeed)
+        );
+
+    // Horizontal and vertical edge bands of each edge colour
+
+    TArray<TArray<FVector2D>> HorizontalBands;
+    TArray<TArray<FVector2D>> VerticalBands;
+
+    HorizontalBands.SetNum(EdgeColorCount);
+    VerticalBands.SetNum(EdgeColorCount);
+
+    for (int32 Color=0; Color<EdgeColorCount; ++Color)
+    {
+        TArray<FVector2D> BorderPoints;
+
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(0.f, 0.f));
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(T, 0.f));
+
+        SamplePatch(
+            HorizontalBands[Color],
+            FBox2D(FVector2D(c, -w), FVector2D(T-c, w)),
+            BorderPoints,
+            GetHash(1, Color, 0, RandomSeed)
+            );
+
+        BorderPoints.Reset();
+
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(0.f, 0.f));
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(0.f, T));
+
+        SamplePatch(
+            VerticalBands[Color],
+            FBox2D(FVector2D(-w, c), FVector2D(w, T-c)),
+            BorderPoints,
+            GetHash(2, Color, 0, RandomSeed)
+            );
+    }
+
+    // Tiles of every edge colour combination and interior variant
+
+    const int32 ColorCount = EdgeColorCount;
+
+    Tiles.Reset();
+    Tiles.SetNum(ColorCount*ColorCount*ColorCount*ColorCount*InteriorVariantCount);
+
+    for (int32 S=0; S<ColorCount; ++S)
+    for (int32 N=0; N<ColorCount; ++N)
+    for (int32 W=0; W<ColorCount; ++W)
+    for (int32 E=0; E<ColorCount; ++E)
+    {
+        TArray<FVector2D> BorderPoints;
+
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(0.f, 0.f));
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(T, 0.f));
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(0.f, T));
+        AppendTranslated(BorderPoints, CornerPoints, FVector2D(T, T));
+        AppendTranslated(BorderPoints, HorizontalBands[S], FVector2D(0.f, 0.f));
+        AppendTranslated(BorderPoints, HorizontalBands[N], FVector2D(0.f, T));
+        AppendTranslated(BorderPoints, VerticalBands[W], FVector2D(0.f, 0.f));
+        AppendTranslated(BorderPoints, VerticalBands[E], FVector2D(T, 0.f));
+
+        for (int32 Variant=0; Variant<InteriorVariantCount; ++Variant)
+        {
+            const int32 TileIndex = GetTileIndex(S, N, W, E, Variant);
+
+            TArray<FVector2D> InteriorPoints;
+
+            SamplePatch(
+                InteriorPoints,
+                FBox2D(FVector2D(w, w), FVector2D(T-w, T-w)),
+                BorderPoints,
+                GetHash(3, TileIndex, 0, RandomSeed)
+                );
+
+            // Assign tile points within tile box
+
+            TArray<FVector2D>& TilePoints(Tiles[TileIndex]);
+
+            TilePoints.Reserve(InteriorPoints.Num() + BorderPoints.Num()/4);
+
+            for (const TArray<FVector2D>* Points : { &BorderPoints, &InteriorPoints })
+            {
+                for (const FVector2D& Point : *Points)
+                {
+                    if (Point.X >= 0.f && Point.X < T && Point.Y >= 0.f && Point.Y < T)
+                    {
+                        TilePoints.Emplace(Point);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FGULPoissonDiscTileSet::GeneratePoints(
+    TArray<FVector2D>& OutPoints,
+    const FBox2D& Bounds,
+    float PointRadius,
+    int32 RandomSeed
+    ) const
+{
+    OutPoints.Reset();
+
+    if (! Bounds.bIsValid || PointRadius <= 0.f || Tiles.Num() < 1)
+    {
+        return;
+    }
+
+    const float TileWorldSize = TileSize * PointRadius;
+
+    const int32 TileX0 = FMath::FloorToInt(Bounds.Min.X / TileWorldSize);
+    const int32 TileY0 = FMath::FloorToInt(Bounds.Min.Y / TileWorldSize);
+    const int32 TileX1 = FMath::FloorToInt(Bounds.Max.X / TileWorldSize);
+    const int32 TileY1 = FMath::FloorToInt(Bounds.Max.Y / TileWorldSize);
+
+    for (int32 y=TileY0; y<=TileY1; ++y)
+    for (int32 x=TileX0; x<=TileX1; ++x)
+    {
+        // Edge colours are hashed by edge location, shared by both tiles
+        // on each side of the edge
+
+        const int32 S = GetHash(x, y,   0, RandomSeed) % EdgeColorCount;
+        const int32 N = GetHash(x, y+1, 0, RandomSeed) % EdgeColorCount;
+        const int32 W = GetHash(x,   y, 1, RandomSeed) % EdgeColorCount;
+        const int32 E = GetHash(x+1, y, 1, RandomSeed) % EdgeColorCount;
+        const int32 Variant = GetHash(x, y, 2, RandomSeed) % InteriorVariantCount;
+
+        const TArray<FVector2D>& TilePoints(Tiles[GetTileIndex(S, N, W, E, Variant)]);
+        const FVector2D TileOrigin(x*TileWorldSize, y*TileWorldSize);
+
+        for (const FVector2D& TilePoint : TilePoints)
+        {
+            const FVector2D Point(TileOrigin + TilePoint*PointRadius);
+
+            if (Point.X >= Bounds.Min.X && Point.X < Bounds.Max.X &&
+                Point.Y >= Bounds.Min.Y && Point.Y < Bounds.Max.Y)
+            {
+                OutPoints.Emplace(Point);
+            }
+        }
+    }
+}
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Poly/GULPolyHierarchyBuilder.h"
+#include "Poly/GULPolyUtilityLibrary.h"
+#include "GULMathLibrary.h"
+
+FGULPolyHierarchyBuilder::FGULPolyHierarchyBuilder(const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    SetRings(PolyGroups);
+}
+
+FGULPolyHierarchyBuilder::FGULPolyHierarchyBuilder(const FGULPolySoup& PolySoup)
+{
+    SetRings(PolySoup);
+}
+
+void FGULPolyHierarchyBuilder::SetRings(const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    Rings.SetNumUninitialized(PolyGroups.Num());
+
+    for (int32 i=0; i<PolyGroups.Num(); ++i)
+    {
+        Rings[i] = PolyGroups[i].Points;
+    }
+}
+
+void FGULPolyHierarchyBuilder::SetRings(const FGULPolySoup& PolySoup)
+{
+    PolySoup.GetRings(Rings);
+}
+
+void FGULPolyHierarchyBuilder::PrepareOuterPolys()
+{
+    const int32 InPolyCount = Rings.Num();
+
+    CandidateIndices.Reset();
+    Orientations.SetNumUninitialized(InPolyCount);
+    PreparedPolys.Reset();
+    PreparedPolys.SetNum(InPolyCount);
+
+    for (int32 PolyIt=0; PolyIt<InPolyCount; ++PolyIt)
+    {
+        const FRingView& Points(Rings[PolyIt]);
+
+        // Only generate index for valid poly
+        if (Points.Num() >= 3)
+        {
+            CandidateIndices.Emplace(PolyIt);
+        }
+
+        // Calculate poly orientation
+        Orientations[PolyIt] = UGULPolyUtilityLibrary::GetOrientation(Points) ? 1 : 0;
+    }
+
+    OuterAreas.SetNumZeroed(InPolyCount);
+
+    // Prepare positive candidate polys for point-in-poly queries
+    for (int32 PolyIndex : CandidateIndices)
+    {
+        if (Orientations[PolyIndex])
+        {
+            PreparedPolys[PolyIndex].Build(Rings[PolyIndex]);
+            OuterAreas[PolyIndex] = FMath::Abs(UGULPolyUtilityLibrary::GetArea(Rings[PolyIndex]));
+        }
+    }
+}
+
+void FGULPolyHierarchyBuilder::GenerateBinGrid()
+{
+    BinOffsets.Reset();
+    BinPolyIndices.Reset();
+
+    // Generate outer poly bounds union
+
+    int32 OuterPolyCount = 0;
+    FIntPoint BoundsMin(MAX_int32, MAX_int32);
+    FIntPoint BoundsMax(MIN_int32, MIN_int32);
+
+    for (int32 PolyIndex : CandidateIndices)
+    {
+        const FGULPreparedPoly& Poly(PreparedPolys[PolyIndex]);
+
+        if (Poly.IsValid())
+        {
+            BoundsMin = BoundsMin.ComponentMin(Poly.GetScaledBoundsMin());
+            BoundsMax = BoundsMax.ComponentMax(Poly.GetScaledBoundsMax());
+            ++OuterPolyCount;
+        }
+    }
+
+    if (OuterPolyCount < 1)
+    {
+        BinDim = FIntPoint::ZeroValue;
+        return;
+    }
+
+    // Generate bin dimension, roughly one bin per outer poly
+
+    const int64 RangeX = static_cast<int64>(BoundsMax.X) - BoundsMin.X + 1;
+    const int64 RangeY = static_cast<int64>(BoundsMax.Y) - BoundsMin.Y + 1;
+    const int32 BinDimAxis = FMath::Clamp(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(OuterPolyCount))), 1, 1024);
+
+    BinSize.X = static_cast<int32>((RangeX + BinDimAxis - 1) / BinDimAxis);
+    BinSize.Y = static_cast<int32>((RangeY + BinDimAxis - 1) / BinDimAxis);
+    BinDim.X = static_cast<int32>((RangeX + BinSize.X - 1) / BinSize.X);
+    BinDim.Y = static_cast<int32>((RangeY + BinSize.Y - 1) / BinSize.Y);
+    BinOrigin = BoundsMin;
+
+    // Count outer polys per bin
+
+    const int32 BinCount = BinDim.X * BinDim.Y;
+
+    BinOffsets.SetNumZeroed(BinCount+1);
+
+    for (int32 Pass=0; Pass<2; ++Pass)
+    {
+        TArray<int32> BinCursors;
+
+        if (Pass > 0)
+        {
+            for (int32 b=0; b<BinCount; ++b)
+            {
+                BinOffsets[b+1] += BinOffsets[b];
+            }
+
+            BinCursors.Append(BinOffsets.GetData(), BinCount);
+            BinPolyIndices.SetNumUninitialized(BinOffsets[BinCount]);
+        }
+
+        // Candidate indices are sorted, bin poly indices
+        // are assigned in ascending order
+        for (int32 PolyIndex : CandidateIndices)
+        {
+            const FGULPreparedPoly& Poly(PreparedPolys[PolyIndex]);
+
+            if (! Poly.IsValid())
+            {
+                continue;
+            }
+
+            const FIntPoint& PolyMin(Poly.GetScaledBoundsMin());
+            const FIntPoint& PolyMax(Poly.GetScaledBoundsMax());
+
+            const int32 Bin0X = static_cast<int32>((static_cast<int64>(PolyMin.X)-BinOrigin.X) / BinSize.X);
+            const int32 Bin0Y = static_cast<int32>((static_cast<int64>(PolyMin.Y)-BinOrigin.Y) / BinSize.Y);
+            const int32 Bin1X = static_cast<int32>((static_cast<int64>(PolyMax.X)-BinOrigin.X) / BinSize.X);
+            const int32 Bin1Y = static_cast<int32>((static_cast<int64>(PolyMax.Y)-BinOrigin.Y) / BinSize.Y);
+
+            for (int32 by=Bin0Y; by<=Bin1Y; ++by)
+            for (int32 bx=Bin0X; bx<=Bin1X; ++bx)
+            {
+                const int32 BinIndex = bx + by*BinDim.X;
+
+                if (Pass > 0)
+                {
+                    BinPolyIndices[BinCursors[BinIndex]++] = PolyIndex;
+                }
+                else
+                {
+                    ++BinOffsets[BinIndex+1];
+                }
+            }
+        }
+    }
+}
+
+TArrayView<const int32> FGULPolyHierarchyBuilder::FindCandidateOuterPolys(const FIntPoint& ScaledPoint) const
+{
+    if (BinOffsets.Num() < 1)
+    {
+        return TArrayView<const int32>();
+    }
+
+    const int64 OffsetX = static_cast<int64>(ScaledPoint.X) - BinOrigin.X;
+    const int64 OffsetY = static_cast<int64>(ScaledPoint.Y) - BinOrigin.Y;
+
+    if (OffsetX < 0 || OffsetY < 0)
+    {
+        return TArrayView<const int32>();
+    }
+
+    const int64 BinX = OffsetX / BinSize.X;
+    const int64 BinY = OffsetY / BinSize.Y;
+
+    if (BinX >= BinDim.X || BinY >= BinDim.Y)
+    {
+        return TArrayView<const int32>();
+    }
+
+    const int32 BinIndex = static_cast<int32>(BinX + BinY*BinDim.X);
+    const int32 BinOffset = BinOffsets[BinIndex];
+
+    return TArrayView<const int32>(
+        BinPolyIndices.GetData()+BinOffset,
+        BinOffsets[BinIndex+1]-BinOffset
+        );
+}
+
+void FGULPolyHierarchyBuilder::GroupPolyHierarchyEvenOdd(TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups)
+{
+    PrepareOuterPolys();
+    GenerateBinGrid();
+
+    const int32 InPolyCount = Rings.Num();
+
+    // Map inner polys to their smallest bounding outer poly
+
+    TArray<int32> OuterPolyIndices;
+    TMap<int32, FGULIndexedPolyGroup> InitialGroupMap;
+
+    for (int32 PolyIndex : CandidateIndices)
+    {
+        // Poly orientation is positive, Assign as outer poly
+        if (Orientations[PolyIndex])
+        {
+            OuterPolyIndices.Emplace(PolyIndex);
+            continue;
+        }
+
+        const FIntPoint InnerPoint = UGULMathLibrary::ScaleToIntPoint(Rings[PolyIndex][0]);
+
+        // Find the smallest bounding poly if any, bin candidates are sorted
+        // by poly index so equal area ties resolve to the lowest index
+        int32 InnermostPolyIndex = INDEX_NONE;
+
+        for (int32 BoundingPolyIndex : FindCandidateOuterPolys(InnerPoint))
+        {
+            if (InnermostPolyIndex != INDEX_NONE &&
+                OuterAreas[BoundingPolyIndex] >= OuterAreas[InnermostPolyIndex])
+            {
+                continue;
+            }
+
+            if (PreparedPolys[BoundingPolyIndex].IsPointOnPoly(InnerPoint))
+            {
+                InnermostPolyIndex = BoundingPolyIndex;
+            }
+        }
+
+        // Bounding poly found, map the connection
+        if (InnermostPolyIndex != INDEX_NONE)
+        {
+            FGULIndexedPolyGroup& PolyGroup(InitialGroupMap.FindOrAdd(InnermostPolyIndex));
+            PolyGroup.OuterPolyIndex = InnermostPolyIndex;
+            PolyGroup.InnerPolyIndices.Emplace(PolyIndex);
+        }
+    }
+
+    // Assign mapped inner poly to outer poly
+
+    while (OuterPolyIndices.Num() > 0)
+    {
+        int32 OuterPolyIndex = OuterPolyIndices.Pop();
+
+        // Create new outer poly group
+
+        OutIndexedPolyGroups.AddDefaulted();
+        FGULIndexedPolyGroup& OuterPolyGroup(OutIndexedPolyGroups.Last());
+
+        OuterPolyGroup.OuterPolyIndex = OuterPolyIndex;
+
+        // Find inner poly (outer poly holes)
+
+        FGULIndexedPolyGroup* MappedOuterPoly(InitialGroupMap.Find(OuterPolyIndex));
+
+        // Outer poly is mapped, move mapped inner poly indices
+        if (MappedOuterPoly)
+        {
+            OuterPolyGroup.InnerPolyIndices = MoveTemp(MappedOuterPoly->InnerPolyIndices);
+        }
+    }
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Poly/GULPolySoup.h"
+#include "Algo/Reverse.h"
+#include "Poly/GULPolyUtilityLibrary.h"
+
+void FGULPolySoup::Reset(int32 RingCount, int32 PointCount)
+{
+    Points.Reset(PointCount);
+    RingOffsets.Reset(RingCount+1);
+    RingBounds.Reset();
+    RingAreas.Reset();
+}
+
+void FGULPolySoup::Reserve(int32 RingCount, int32 PointCount)
+{
+    Points.Reserve(PointCount);
+    RingOffsets.Reserve(RingCount+1);
+}
+
+int32 FGULPolySoup::AddRing(FRingView RingPoints)
+{
+    AddRingUninitialized(RingPoints.Num());
+
+    const int32 RingIndex = GetRingNum()-1;
+
+    if (RingPoints.Num() > 0)
+    {
+        FMemory::Memcpy(
+            Points.GetData()+RingOffsets[RingIndex],
+            RingPoints.GetData(),
+            RingPoints.Num() * sizeof(FVector2D)
+            );
+    }
+
+    return RingIndex;
+}
+
+TArrayView<FVector2D> FGULPolySoup::AddRingUninitialized(int32 PointCount)
+{
+    check(PointCount >= 0);
+
+    if (RingOffsets.Num() < 1)
+    {
+        RingOffsets.Emplace(0);
+    }
+
+    // Invalidate ring cache
+    ClearRingCache();
+
+    const int32 PointOffset = Points.Num();
+
+    Points.AddUninitialized(PointCount);
+    RingOffsets.Emplace(PointOffset+PointCount);
+
+    return TArrayView<FVector2D>(Points.GetData()+PointOffset, PointCount);
+}
+
+void FGULPolySoup::ReverseRing(int32 RingIndex)
+{
+    check(IsValidRingIndex(RingIndex));
+
+    Algo::Reverse(Points.GetData()+RingOffsets[RingIndex], GetRingPointNum(RingIndex));
+
+    // Update cached ring area orientation
+    if (HasRingCache())
+    {
+        RingAreas[RingIndex] = -RingAreas[RingIndex];
+    }
+}
+
+void FGULPolySoup::GetRings(TArray<FRingView>& OutRings) const
+{
+    const int32 RingCount = GetRingNum();
+
+    OutRings.Reset(RingCount);
+
+    for (int32 i=0; i<RingCount; ++i)
+    {
+        OutRings.Emplace(GetRing(i));
+    }
+}
+
+void FGULPolySoup::UpdateRingCache()
+{
+    const int32 RingCount = GetRingNum();
+
+    RingBounds.SetNumUninitialized(RingCount);
+    RingAreas.SetNumUninitialized(RingCount);
+
+    for (int32 i=0; i<RingCount; ++i)
+    {
+        const FRingView Ring(GetRing(i));
+
+        RingBounds[i] = UGULPolyUtilityLibrary::GetPointsBounds(Ring);
+        RingAreas[i] = UGULPolyUtilityLibrary::GetArea(Ring);
+    }
+}
+
+void FGULPolySoup::ClearRingCache()
+{
+    RingBounds.Reset();
+    RingAreas.Reset();
+}
+
+void FGULPolySoup::FromGroups(const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    const int32 RingCount = PolyGroups.Num();
+
+    int32 PointCount = 0;
+
+    for (const FGULVector2DGroup& PolyGroup : PolyGroups)
+    {
+        PointCount += PolyGroup.Points.Num();
+    }
+
+    Reset(RingCount, PointCount);
+
+    for (const FGULVector2DGroup& PolyGroup : PolyGroups)
+    {
+        AddRing(PolyGroup.Points);
+    }
+}
+
+void FGULPolySoup::ToGroups(TArray<FGULVector2DGroup>& OutPolyGroups) const
+{
+    const int32 RingCount = GetRingNum();
+
+    OutPolyGroups.Reset();
+    OutPolyGroups.SetNum(RingCount);
+
+    for (int32 i=0; i<RingCount; ++i)
+    {
+        ToGroup(OutPolyGroups[i], i);
+    }
+}
+
+void FGULPolySoup::ToGroup(FGULVector2DGroup& OutPolyGroup, int32 RingIndex) const
+{
+    const FRingView Ring(GetRing(RingIndex));
+
+    OutPolyGroup.Points.Reset(Ring.Num());
+    OutPolyGroup.Points.Append(Ring.GetData(), Ring.Num());
+}
@@ -28,6 +28,7 @@
 #include "Poly/GULPolyUtilityLibrary.h"
 #include "Geom/GULGeometryUtilityLibrary.h"
 #include "GULMathLibrary.h"
+#include "Poly/GULPolyHierarchyBuilder.h"
 
 TArray<FVector2D> UGULPolyUtilityLibrary::K2_FitPoints(const TArray<FVector2D>& Points, FVector2D Dimension, float FitScale)
 {
@@ -546,6 +547,23 @@ void UGULPolyUtilityLibrary::SubdividePolylinesWithinLength(
     bool bClosePolygon,
     bool bClosePolygonOutput
     )
+{
+    SubdividePolylinesWithinLength(
+        OutPoints,
+        TArrayView<const FVector2D>(InPoints),
+        SubdivisionLength,
+        bClosePolygon,
+        bClosePolygonOutput
+        );
+}
+
+void UGULPolyUtilityLibrary::SubdividePolylinesWithinLength(
+    TArray<FVector2D>& OutPoints,
+    TArrayView<const FVector2D> InPoints,
+    float SubdivisionLength,
+    bool bClosePolygon,
+    bool bClosePolygonOutput
+    )
 {
     if (InPoints.Num() < 2 || SubdivisionLength < KINDA_SMALL_NUMBER)
     {
@@ -976,158 +994,27 @@ void UGULPolyUtilityLibrary::FixOrientations(TArray<FGULVector2DGroup>& InOutPol
     }
 }
 
-void UGULPolyUtilityLibrary::GroupPolyHierarchyEvenOdd(TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups, const TArray<FGULVector2DGroup>& PolyGroups)
+void UGULPolyUtilityLibrary::FixOrientations(FGULPolySoup& InOutPolySoup)
 {
-    const int32 InPolyCount = PolyGroups.Num();
-
-    // Generate candidate indices
-
-    TArray<int32> CandidateIndices;
-    TArray<int32> Orientations;
-
-    Orientations.SetNumUninitialized(InPolyCount);
-
-    for (int32 PolyIt=0; PolyIt<InPolyCount; ++PolyIt)
-    {
-        const TArray<FVector2D>& Points(PolyGroups[PolyIt].Points);
-
-        // Only generate index for valid poly
-        if (Points.Num() >= 3)
-        {
-            CandidateIndices.Emplace(PolyIt);
-        }
-
-        // Calculate poly orientation
-        Orientations[PolyIt] = GetOrientation(Points) ? 1 : 0;
-    }
-
-    TArray<int32> OuterPolyIndices;
-    TMap<int32, FGULIndexedPolyGroup> InitialGroupMap;
-
-    for (int32 PolyIndex : CandidateIndices)
-    {
-        const TArray<FVector2D>& Points(PolyGroups[PolyIndex].Points);
-
-        // Poly orientation is positive, Assign as outer poly
-        if (Orientations[PolyIndex])
-        {
-            OuterPolyIndices.Emplace(PolyIndex);
-            continue;
-        }
-
-        FVector2D InnerPoint(Points[0]);
-
-        // Find bounding poly if any
-        for (int32 BoundingPolyIndex : CandidateIndices)
-        {
-            // Skip the same poly or another inner poly
-            if (BoundingPolyIndex == PolyIndex || Orientations[BoundingPolyIndex] < 1)
-            {
-                continue;
-            }
-
-            const TArray<FVector2D>& BoundingPoints(PolyGroups[BoundingPolyIndex].Points);
-
-            // Bounding poly found, map the connection
-            if (IsPointOnPoly(InnerPoint, BoundingPoints))
-            {
-                FGULIndexedPolyGroup& PolyGroup(InitialGroupMap.FindOrAdd(BoundingPolyIndex));
-                PolyGroup.OuterPolyIndex = BoundingPolyIndex;
-                PolyGroup.InnerPolyIndices.Emplace(PolyIndex);
-                break;
-            }
-        }
-    }
-
-    // Assign mapped inner poly to outer poly
-    while (OuterPolyIndices.Num() > 0)
+    for (int32 RingIt=0; RingIt<InOutPolySoup.GetRingNum(); ++RingIt)
     {
-        int32 OuterPolyIndex = OuterPolyIndices.Pop();
-
-        // Create new outer poly group
-
-        OutIndexedPolyGroups.AddDefaulted();
-        FGULIndexedPolyGroup& OuterPolyGroup(OutIndexedPolyGroups.Last());
-
-        OuterPolyGroup.OuterPolyIndex = OuterPolyIndex;
-
-        // Find inner poly (outer poly holes)
-
-        FGULIndexedPolyGroup* MappedOuterPoly(InitialGroupMap.Find(OuterPolyIndex));
-
-        // Outer poly is not mapped, no inner poly, continue
-        if (! MappedOuterPoly)
+        if (! GetOrientation(InOutPolySoup.GetRing(RingIt)))
         {
-            continue;
-        }
-
-        // Move mapped inner poly indices
-        OuterPolyGroup.InnerPolyIndices = MoveTemp(MappedOuterPoly->InnerPolyIndices);
-
-        // Remove mapped outer poly index
-        InitialGroupMap.Remove(OuterPolyIndex);
-
-        // Find inner poly within current mapped inner poly
-        // and add them as new outer poly
-        for (int32 InnerPolyIndex : OuterPolyGroup.InnerPolyIndices)
-        {
-            FGULIndexedPolyGroup* MappedInnerPoly(InitialGroupMap.Find(InnerPolyIndex));
-
-            if (MappedInnerPoly)
-            {
-                OuterPolyIndices.Append(MappedInnerPoly->InnerPolyIndices);
-                InitialGroupMap.Remove(InnerPolyIndex);
-            }
+            InOutPolySoup.ReverseRing(RingIt);
         }
     }
+}
 
-    // Move inner poly to the innermost outer poly
-    for (int32 pi0=0; pi0<OutIndexedPolyGroups.Num(); ++pi0)
-    {
-        FGULIndexedPolyGroup& IndexGroup0(OutIndexedPolyGroups[pi0]);
-        int32 OuterIndex0 = IndexGroup0.OuterPolyIndex;
-
-        const TArray<FVector2D>& OuterPoly0(PolyGroups[OuterIndex0].Points);
-        const FVector2D& OuterPoint0(OuterPoly0[0]);
-
-        for (int32 pi1=0; pi1<OutIndexedPolyGroups.Num(); ++pi1)
-        {
-            // Skip checking the same poly
-            if (pi1 == pi0)
-            {
-                continue;
-            }
-
-            FGULIndexedPolyGroup& IndexGroup1(OutIndexedPolyGroups[pi1]);
-            TArray<int32>& InnerIndices(IndexGroup1.InnerPolyIndices);
-            int32 OuterIndex1 = IndexGroup1.OuterPolyIndex;
-
-            // OuterPoly0 is not within OuterPoly1, skip
-            if (! IsPointOnPoly(OuterPoint0, PolyGroups[OuterIndex1].Points))
-            {
-                continue;
-            }
-
-            // OuterPoly0 is within OuterPoly1, move any OuterPoly0 inner poly
-            // that is within OuterPoly1 as OuterPoly1 inner poly
-
-            InnerIndices.RemoveAll(
-                [&PolyGroups, &IndexGroup0, &OuterPoly0](int32 InnerIndex)
-                {
-                    bool bMoveInner = IsPointOnPoly(
-                        PolyGroups[InnerIndex].Points[0],
-                        OuterPoly0
-                        );
-
-                    if (bMoveInner)
-                    {
-                        IndexGroup0.InnerPolyIndices.Emplace(InnerIndex);
-                    }
+void UGULPolyUtilityLibrary::GroupPolyHierarchyEvenOdd(TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups, const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    FGULPolyHierarchyBuilder HierarchyBuilder(PolyGroups);
+    HierarchyBuilder.GroupPolyHierarchyEvenOdd(OutIndexedPolyGroups);
+}
 
-                    return bMoveInner;
-                } );
-        }
-    }
+void UGULPolyUtilityLibrary::GroupPolyHierarchyEvenOdd(TArray<FGULIndexedPolyGroup>& OutIndexedPolyGroups, const FGULPolySoup& PolySoup)
+{
+    FGULPolyHierarchyBuilder HierarchyBuilder(PolySoup);
+    HierarchyBuilder.GroupPolyHierarchyEvenOdd(OutIndexedPolyGroups);
 }
 
 void UGULPolyUtilityLibrary::ConvertIndexedPolyGroupToVectorGroup(FGULVectorGroup& OutVectorGroup, const FGULIndexedPolyGroup& InIndexedPolyGroup, const TArray<FGULVector2DGroup>& InPolyGroups, float ZPosition)
@@ -1156,9 +1043,15 @@ void UGULPolyUtilityLibrary::ConvertIndexedPolyGroupToVectorGroup(FGULVectorGrou
     }
 }
 
-void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArray<FVector2D>& InPoints, const FBox2D& InBounds)
+void UGULPolyUtilityLibrary::ClipBoundsImpl(
+    TArray<FVector2D>& ClipPoints0,
+    TArray<FVector2D>& ClipPoints1,
+    TArrayView<const FVector2D> InPoints,
+    const FBox2D& InBounds
+    )
 {
-    OutPoints.Reset();
+    ClipPoints0.Reset();
+    ClipPoints1.Reset();
 
     if (InPoints.Num() < 3 ||
         InBounds.Min.X > InBounds.Max.X ||
@@ -1167,8 +1060,7 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArr
         return;
     }
 
-    TArray<FVector2D> ClipPoints0;
-    TArray<FVector2D> ClipPoints1(InPoints);
+    ClipPoints1.Append(InPoints.GetData(), InPoints.Num());
 
     // Ensure open poly (first point is different from the last)
     if (ClipPoints1[0].Equals(ClipPoints1.Last()))
@@ -1176,12 +1068,38 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArr
         ClipPoints1.Pop();
     }
 
+    // Gather point outcodes, skip bounds sides without any outside point
+    // and abort clip if all points are outside of the same bounds side
+
+    int32 OutcodeMask = 0;
+    int32 OutcodeCommon = ~0;
+
+    for (const FVector2D& Point : ClipPoints1)
+    {
+        const int32 Outcode = UGULGeometryUtility::GetBoundsOutcode(Point, InBounds);
+        OutcodeMask |= Outcode;
+        OutcodeCommon &= Outcode;
+    }
+
+    if (OutcodeCommon != 0)
+    {
+        ClipPoints1.Reset();
+        return;
+    }
+
     // Clip poly on each bounds side
     for (int32 s=0; s<4; ++s)
     {
+        const EGULBox2DClip ClipCode = static_cast<EGULBox2DClip>(1 << s);
+
+        if ((OutcodeMask & ClipCode) == 0)
+        {
+            continue;
+        }
+
         // Swap point containers
-        ClipPoints0 = MoveTemp(ClipPoints1);
-        ClipPoints1 = TArray<FVector2D>();
+        Swap(ClipPoints0, ClipPoints1);
+        ClipPoints1.Reset();
 
         // Abort clip if there is not sufficient points left
 
@@ -1196,8 +1114,6 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArr
 
         // Clip poly on bounds side
 
-        const EGULBox2DClip ClipCode = static_cast<EGULBox2DClip>(1 << s);
-
         FVector2D P0;
         FVector2D P1(ClipPoints0[PointCount-1]);
 
@@ -1239,8 +1155,8 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArr
 
     // Filter duplicate points
     {
-        ClipPoints0 = MoveTemp(ClipPoints1);
-        ClipPoints1 = TArray<FVector2D>();
+        Swap(ClipPoints0, ClipPoints1);
+        ClipPoints1.Reset();
 
         const int32 PointCount = ClipPoints0.Num();
 
@@ -1269,6 +1185,15 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, const TArr
         }
     }
 
+}
+
+void UGULPolyUtilityLibrary::ClipBounds(TArray<FVector2D>& OutPoints, TArrayView<const FVector2D> InPoints, const FBox2D& InBounds)
+{
+    TArray<FVector2D> ClipPoints0;
+    TArray<FVector2D> ClipPoints1;
+
+    ClipBoundsImpl(ClipPoints0, ClipPoints1, InPoints, InBounds);
+
     OutPoints = MoveTemp(ClipPoints1);
 }
 
@@ -1282,3 +1207,27 @@ void UGULPolyUtilityLibrary::ClipBounds(TArray<FGULVector2DGroup>& OutPolyGroups
         ClipBounds(OutPolyGroups[i].Points, InPolyGroups[i].Points, InBounds);
     }
 }
+
+void UGULPolyUtilityLibrary::ClipBounds(FGULPolySoup& OutPolySoup, const FGULPolySoup& InPolySoup, const FBox2D& InBounds)
+{
+    // Clip a copy of the input if both soups are the same instance
+    if (&OutPolySoup == &InPolySoup)
+    {
+        const FGULPolySoup InPolySoupCopy(InPolySoup);
+        ClipBounds(OutPolySoup, InPolySoupCopy, InBounds);
+        return;
+    }
+
+    const int32 RingCount = InPolySoup.GetRingNum();
+
+    OutPolySoup.Reset(RingCount, InPolySoup.GetPointNum());
+
+    TArray<FVector2D> ClipPoints0;
+    TArray<FVector2D> ClipPoints1;
+
+    for (int32 i=0; i<RingCount; ++i)
+    {
+        ClipBoundsImpl(ClipPoints0, ClipPoints1, InPolySoup.GetRing(i), InBounds);
+        OutPolySoup.AddRing(ClipPoints1);
+    }
+}
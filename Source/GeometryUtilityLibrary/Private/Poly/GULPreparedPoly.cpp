@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Poly/GULPreparedPoly.h"
+#include "Async/ParallelFor.h"
+
+#define GUL_PREPARED_POLY_CLASSIFY_CHUNK_SIZE 1024
+
+void FGULPreparedPoly::Build(TArrayView<const FVector2D> Points)
+{
+    Reset();
+
+    const int32 EdgeCount = Points.Num();
+
+    if (EdgeCount < 3)
+    {
+        return;
+    }
+
+    // Generate quantized edges and bounds
+
+    TArray<FEdge> Edges;
+    Edges.SetNumUninitialized(EdgeCount);
+
+    FIntPoint ip = UGULMathLibrary::ScaleToIntPoint(Points[0]);
+
+    BoundsMin = ip;
+    BoundsMax = ip;
+
+    for (int32 i=1; i<=EdgeCount; ++i)
+    {
+        FIntPoint ipNext = (i==EdgeCount)
+            ? UGULMathLibrary::ScaleToIntPoint(Points[0])
+            : UGULMathLibrary::ScaleToIntPoint(Points[i]);
+
+        Edges[i-1].P0 = ip;
+        Edges[i-1].P1 = ipNext;
+
+        BoundsMin = BoundsMin.ComponentMin(ipNext);
+        BoundsMax = BoundsMax.ComponentMax(ipNext);
+
+        ip = ipNext;
+    }
+
+    // Generate scanline bins
+
+    const int64 RangeY = static_cast<int64>(BoundsMax.Y) - BoundsMin.Y + 1;
+
+    BinCount = static_cast<int32>(FMath::Min<int64>(EdgeCount, RangeY));
+    BinHeight = static_cast<int32>((RangeY + BinCount - 1) / BinCount);
+    BinCount = static_cast<int32>((RangeY + BinHeight - 1) / BinHeight);
+
+    // Count edges per bin
+
+    BinOffsets.SetNumZeroed(BinCount+1);
+
+    for (const FEdge& Edge : Edges)
+    {
+        const int32 b0 = GetBinIndex(FMath::Min(Edge.P0.Y, Edge.P1.Y));
+        const int32 b1 = GetBinIndex(FMath::Max(Edge.P0.Y, Edge.P1.Y));
+
+        for (int32 b=b0; b<=b1; ++b)
+        {
+            ++BinOffsets[b+1];
+        }
+    }
+
+    for (int32 b=0; b<BinCount; ++b)
+    {
+        BinOffsets[b+1] += BinOffsets[b];
+    }
+
+    // Assign edges to bins
+
+    TArray<int32> BinCursors(BinOffsets.GetData(), BinCount);
+    BinEdges.SetNumUninitialized(BinOffsets[BinCount]);
+
+    for (const FEdge& Edge : Edges)
+    {
+        const int32 b0 = GetBinIndex(FMath::Min(Edge.P0.Y, Edge.P1.Y));
+        const int32 b1 = GetBinIndex(FMath::Max(Edge.P0.Y, Edge.P1.Y));
+
+        for (int32 b=b0; b<=b1; ++b)
+        {
+            BinEdges[BinCursors[b]++] = Edge;
+        }
+    }
+}
+
+void FGULPreparedPoly::Reset()
+{
+    BinEdges.Reset();
+    BinOffsets.Reset();
+
+    BinCount = 0;
+    BinHeight = 1;
+
+    BoundsMin = FIntPoint::ZeroValue;
+    BoundsMax = FIntPoint::ZeroValue;
+}
+
+bool FGULPreparedPoly::IsPointOnPoly(const FIntPoint& ScaledPoint) const
+{
+    // Points outside poly bounds never cross or lie on any edge
+    if (! IsValid() || ! IsOnBounds(ScaledPoint))
+    {
+        return false;
+    }
+
+    const int32 BinIndex = GetBinIndex(ScaledPoint.Y);
+    const int32 EdgeEnd = BinOffsets[BinIndex+1];
+
+    int32 result = 0;
+
+    for (int32 i=BinOffsets[BinIndex]; i<EdgeEnd; ++i)
+    {
+        const FEdge& Edge(BinEdges[i]);
+        const int32 EdgeResult = TestEdgeCrossing(ScaledPoint, Edge.P0, Edge.P1);
+
+        // Point on poly boundary
+        if (EdgeResult < 0)
+        {
+            return true;
+        }
+
+        result ^= EdgeResult;
+    }
+
+    return (result != 0);
+}
+
+void FGULPreparedPoly::ClassifyPoints(TArrayView<const FVector2D> Points, TBitArray<>& OutResults) const
+{
+    ClassifyPoints(Points, OutResults, MakeArrayView(this, 1));
+}
+
+void FGULPreparedPoly::ClassifyPoints(
+    TArrayView<const FVector2D> Points,
+    TBitArray<>& OutResults,
+    TArrayView<const FGULPreparedPoly> Polys
+    )
+{
+    const int32 PointCount = Points.Num();
+    const int32 ChunkSize = GUL_PREPARED_POLY_CLASSIFY_CHUNK_SIZE;
+    const int32 ChunkCount = FMath::DivideAndRoundUp(PointCount, ChunkSize);
+
+    OutResults.Init(false, PointCount);
+
+    // Chunk size is a multiple of bit array word size,
+    // each chunk writes to its own bit array words
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+    {
+        const int32 i0 = ChunkIndex * ChunkSize;
+        const int32 i1 = FMath::Min(i0+ChunkSize, PointCount);
+
+        for (int32 i=i0; i<i1; ++i)
+        {
+            const FIntPoint ScaledPoint = UGULMathLibrary::ScaleToIntPoint(Points[i]);
+
+            for (const FGULPreparedPoly& Poly : Polys)
+            {
+                if (Poly.IsPointOnPoly(ScaledPoint))
+                {
+                    OutResults[i] = true;
+                    break;
+                }
+            }
+        }
+    } );
+}
+
+void FGULPreparedPolyGroup::Build(const FGULIndexedPolyGroup& IndexGroup, const TArray<FGULVector2DGroup>& PolyGroups)
+{
+    Reset();
+
+    if (! IndexGroup.IsValidIndexGroup(PolyGroups))
+    {
+        return;
+    }
+
+    Outer.Build(IndexGroup.GetOuter(PolyGroups).Points);
+
+    Inners.SetNum(IndexGroup.GetInnerNum());
+
+    for (int32 i=0; i<Inners.Num(); ++i)
+    {
+        Inners[i].Build(IndexGroup.GetInner(PolyGroups, i).Points);
+    }
+}
+
+void FGULPreparedPolyGroup::Reset()
+{
+    Outer.Reset();
+    Inners.Reset();
+}
+
+bool FGULPreparedPolyGroup::IsPointOnPoly(const FIntPoint& ScaledPoint) const
+{
+    if (Outer.IsPointOnPoly(ScaledPoint))
+    {
+        for (const FGULPreparedPoly& Inner : Inners)
+        {
+            if (Inner.IsPointOnPoly(ScaledPoint))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void FGULPreparedPolyGroup::ClassifyPoints(TArrayView<const FVector2D> Points, TBitArray<>& OutResults) const
+{
+    ClassifyPoints(Points, OutResults, MakeArrayView(this, 1));
+}
+
+void FGULPreparedPolyGroup::ClassifyPoints(
+    TArrayView<const FVector2D> Points,
+    TBitArray<>& OutResults,
+    TArrayView<const FGULPreparedPolyGroup> PolyGroups
+    )
+{
+    const int32 PointCount = Points.Num();
+    const int32 ChunkSize = GUL_PREPARED_POLY_CLASSIFY_CHUNK_SIZE;
+    const int32 ChunkCount = FMath::DivideAndRoundUp(PointCount, ChunkSize);
+
+    OutResults.Init(false, PointCount);
+
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+    {
+        const int32 i0 = ChunkIndex * ChunkSize;
+        const int32 i1 = FMath::Min(i0+ChunkSize, PointCount);
+
+        for (int32 i=i0; i<i1; ++i)
+        {
+            const FIntPoint ScaledPoint = UGULMathLibrary::ScaleToIntPoint(Points[i]);
+
+            for (const FGULPreparedPolyGroup& PolyGroup : PolyGroups)
+            {
+                if (PolyGroup.IsPointOnPoly(ScaledPoint))
+                {
+                    OutResults[i] = true;
+                    break;
+                }
+            }
+        }
+    } );
+}
+
+#undef GUL_PREPARED_POLY_CLASSIFY_CHUNK_SIZE